@@ -0,0 +1,258 @@
+/**
+   Copyright (C) 2016 Diego Rubert
+
+   This file is part of the O(k)-approximation algorithm implementation
+   for the DCJ distance on linear unichromosomal genomes in:
+
+   Diego P. Rubert, Pedro Feijão, Marília D. V. Braga, Jens Stoye and Fábio V. Martinez
+   A Linear Time Approximation Algorithm for the DCJ Distance for Genomes with Bounded Number of Duplicates
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdio>
+#include <vector>
+#include <algorithm>
+#include <functional>
+
+#include "graph.hpp"
+#include "thread-pool.hpp"
+#include "genome.hpp"
+#include "gene-matching.hpp"
+#include "name-index.hpp"
+#include "blast.hpp"
+#include "adjacency-graph.hpp"
+
+
+using std::vector;
+
+
+
+/*******************
+ ** AUX FUNCTIONS **
+ *******************/
+// Adds a vertex with extremities x and y to part of ag, recording it
+// as the vertex of each extremity
+static void addAdjacency(Graph *ag, char part, Extremity x, Extremity y, vector<int> &vertexOf)
+{
+  Vertex *v = ag->addVertex((const char *) 0x0, part);
+
+  v->setExtremities(x.getId(), x.getType(), y.getId(), y.getType());
+  if (x.getType() != Extremity::UNDEF)
+    vertexOf[x.index()] = v->getId();
+  if (y.getType() != Extremity::UNDEF)
+    vertexOf[y.index()] = v->getId();
+}
+
+// Adds the adjacencies of genome g (genes with ids from offset + 1)
+// to part of ag
+static void addAdjacencies(Graph *ag, const Genome &g, int offset, char part, vector<int> &vertexOf)
+{
+  const Extremity telomere(0, Extremity::UNDEF);
+  auto left = [&](int i) { return Extremity(offset + i + 1, g.getGene(i).reverse ? Extremity::HEAD : Extremity::TAIL); };
+  auto right = [&](int i) { return !left(i); };
+
+  for (int c = 0; c < g.getChromosomes(); c++) {
+    int begin = g.chromosomeBegin(c), end = g.chromosomeEnd(c);
+    if (begin == end)
+      continue;
+
+    // circular: the last gene is followed by the first one
+    addAdjacency(ag, part, g.isCircular(c) ? right(end - 1) : telomere, left(begin), vertexOf);
+    for (int i = begin + 1; i < end; i++)
+      addAdjacency(ag, part, right(i - 1), left(i), vertexOf);
+    if (!g.isCircular(c))
+      addAdjacency(ag, part, right(end - 1), telomere, vertexOf);
+  }
+}
+
+// Runs body over [0, n), on pool if any
+static void forRange(ThreadPool *pool, long n, const std::function<void(long, long, long)> &body)
+{
+  if (pool)
+    pool->parallelFor(0, n, body);
+  else
+    body(0, n, 0);
+}
+
+// Adds the tail and head edges of genes x (genome A) and y (genome B)
+static void addPair(Graph *ag, const vector<int> &vertexOf, int x, int y, double weight)
+{
+  Extremity tx(x, Extremity::TAIL), ty(y, Extremity::TAIL), hx(x, Extremity::HEAD), hy(y, Extremity::HEAD);
+  char label[32]; // labels identify edges in cycle signatures
+
+  snprintf(label, sizeof(label), "%dt%dt", x, y);
+  Edge *t = ag->addEdge(vertexOf[tx.index()], vertexOf[ty.index()], label);
+  snprintf(label, sizeof(label), "%dh%dh", x, y);
+  Edge *h = ag->addEdge(vertexOf[hx.index()], vertexOf[hy.index()], label);
+
+  t->setExtremities(x, Extremity::TAIL, y, Extremity::TAIL);
+  h->setExtremities(x, Extremity::HEAD, y, Extremity::HEAD);
+  t->setSibling(h);
+  h->setSibling(t);
+  if (weight != 1.0) {
+    t->setWeight(weight);
+    h->setWeight(weight);
+  }
+}
+
+// Adds the tail and head edges of every pair of genes p.a (genome A)
+// and p.b (genome B), given by their ids, in order (in bulk on pool)
+static void addPairs(Graph *ag, const vector<int> &vertexOf, const vector<GenePair> &pairs, ThreadPool *pool)
+{
+  vector<std::pair<int, int>> ends(2 * pairs.size());
+  vector<Edge *> added;
+
+  if (pool == NULL) {
+    for (auto &p : pairs)
+      addPair(ag, vertexOf, p.a, p.b, p.weight);
+    return;
+  }
+
+  forRange(pool, pairs.size(), [&](long from, long to, long) {
+      for (long k = from; k < to; k++) {
+        int x = pairs[k].a, y = pairs[k].b;
+        ends[2*k] = std::make_pair(vertexOf[Extremity(x, Extremity::TAIL).index()], vertexOf[Extremity(y, Extremity::TAIL).index()]);
+        ends[2*k+1] = std::make_pair(vertexOf[Extremity(x, Extremity::HEAD).index()], vertexOf[Extremity(y, Extremity::HEAD).index()]);
+      }
+    });
+  ag->addEdges(ends, added, pool);
+
+  forRange(pool, pairs.size(), [&](long from, long to, long) {
+      char label[32]; // labels identify edges in cycle signatures
+
+      for (long k = from; k < to; k++) {
+        int x = pairs[k].a, y = pairs[k].b;
+        Edge *t = added[2*k], *h = added[2*k+1];
+
+        snprintf(label, sizeof(label), "%dt%dt", x, y);
+        t->setLabel(label);
+        t->getAdjRef()->setLabel(label);
+        snprintf(label, sizeof(label), "%dh%dh", x, y);
+        h->setLabel(label);
+        h->getAdjRef()->setLabel(label);
+
+        t->setExtremities(x, Extremity::TAIL, y, Extremity::TAIL);
+        h->setExtremities(x, Extremity::HEAD, y, Extremity::HEAD);
+        t->setSibling(h);
+        h->setSibling(t);
+        if (pairs[k].weight != 1.0) {
+          t->setWeight(pairs[k].weight);
+          h->setWeight(pairs[k].weight);
+        }
+      }
+    });
+}
+
+// Creates the vertices of the adjacency graph of a and b
+static Graph *adjacencies(const Genome &a, const Genome &b, vector<int> &vertexOf)
+{
+  int n = a.getGenes() + b.getGenes(), vertices = n + 2 * (a.getChromosomes() + b.getChromosomes());
+  Graph *ag = new Graph("adjacency graph", vertices > 16 ? vertices : 16);
+
+  vertexOf.assign(2 * (n + 1), -1);
+  addAdjacencies(ag, a, 0, 'A', vertexOf);
+  addAdjacencies(ag, b, a.getGenes(), 'B', vertexOf);
+  return ag;
+}
+
+
+
+/***********************
+ ** BUILDER FUNCTIONS **
+ ***********************/
+Graph *buildAdjacencyGraph(const Genome &a, const Genome &b, ThreadPool *pool)
+{
+  vector<int> vertexOf;
+  Graph *ag = adjacencies(a, b, vertexOf);
+  int families = (a.getMaxFamily() > b.getMaxFamily() ? a.getMaxFamily() : b.getMaxFamily()) + 1;
+  vector<int> off(families + 1, 0), bucket(b.getGenes());
+  vector<long> first(a.getGenes() + 1, 0);
+  vector<GenePair> pairs;
+
+  // genes of B bucketed by family (counting sort)
+  for (int j = 0; j < b.getGenes(); j++)
+    off[b.getGene(j).family + 1]++;
+  for (int f = 0; f < families; f++)
+    off[f+1] += off[f];
+  vector<int> pos(off.begin(), off.end() - 1);
+  for (int j = 0; j < b.getGenes(); j++)
+    bucket[pos[b.getGene(j).family]++] = j;
+
+  // pairs of each gene of A go after those of the genes before it
+  for (int i = 0; i < a.getGenes(); i++) {
+    int f = a.getGene(i).family;
+    first[i+1] = first[i] + (f > 0 ? off[f+1] - off[f] : 0);
+  }
+  pairs.resize(first.back());
+  forRange(pool, a.getGenes(), [&](long from, long to, long) {
+      for (long i = from; i < to; i++) {
+        int f = a.getGene(i).family;
+        for (long k = first[i]; k < first[i+1]; k++)
+          pairs[k] = GenePair{geneIdA(i), geneIdB(a, bucket[off[f] + k - first[i]]), 1.0};
+      }
+    });
+
+  addPairs(ag, vertexOf, pairs, pool);
+  return ag;
+}
+
+Graph *buildAdjacencyGraph(const Genome &a, const Genome &b, const vector<GenePair> &pairs, ThreadPool *pool)
+{
+  vector<int> vertexOf;
+  Graph *ag = adjacencies(a, b, vertexOf);
+  vector<GenePair> ids;
+
+  for (auto &p : pairs)
+    if (p.a >= 0 && p.a < a.getGenes() && p.b >= 0 && p.b < b.getGenes())
+      ids.push_back(GenePair{geneIdA(p.a), geneIdB(a, p.b), p.weight});
+
+  addPairs(ag, vertexOf, ids, pool);
+  return ag;
+}
+
+Graph *buildAdjacencyGraph(const Genome &a, const Genome &b, const NameIndex &names, const vector<SimilarityEdge> &edges,
+                           ThreadPool *pool)
+{
+  vector<int> posA(names.size(), -1), posB(names.size(), -1);
+  vector<GenePair> pairs;
+
+  for (int i = 0; i < a.getGenes(); i++) {
+    int id = names.find(a.getGeneName(i));
+    if (id >= 0)
+      posA[id] = i;
+  }
+  for (int j = 0; j < b.getGenes(); j++) {
+    int id = names.find(b.getGeneName(j));
+    if (id >= 0)
+      posB[id] = j;
+  }
+
+  for (auto &e : edges) {
+    if (posA[e.a] >= 0 && posB[e.b] >= 0)
+      pairs.push_back(GenePair{posA[e.a], posB[e.b], e.weight});
+    else if (posB[e.a] >= 0 && posA[e.b] >= 0)
+      pairs.push_back(GenePair{posA[e.b], posB[e.a], e.weight});
+  }
+
+  // one pair per gene pair, the heaviest hit
+  std::sort(pairs.begin(), pairs.end(), [](const GenePair &x, const GenePair &y) {
+      return x.a != y.a ? x.a < y.a : (x.b != y.b ? x.b < y.b : x.weight > y.weight);
+    });
+  pairs.erase(std::unique(pairs.begin(), pairs.end(), [](const GenePair &x, const GenePair &y) {
+        return x.a == y.a && x.b == y.b;
+      }), pairs.end());
+
+  return buildAdjacencyGraph(a, b, pairs, pool);
+}
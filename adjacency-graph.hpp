@@ -0,0 +1,91 @@
+/**
+   Copyright (C) 2016 Diego Rubert
+
+   This file is part of the O(k)-approximation algorithm implementation
+   for the DCJ distance on linear unichromosomal genomes in:
+
+   Diego P. Rubert, Pedro Feijão, Marília D. V. Braga, Jens Stoye and Fábio V. Martinez
+   A Linear Time Approximation Algorithm for the DCJ Distance for Genomes with Bounded Number of Duplicates
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+  Builds the adjacency graph of two genomes. Every adjacency (pair of
+  consecutive gene extremities, or a gene extremity at the end of a
+  linear chromosome) becomes a vertex with its extremities, genome A
+  in part 'A' and genome B in part 'B'. Every candidate gene pair
+  (a, b) becomes two sibling edges, one joining the vertices of the
+  tails of a and b and one joining those of the heads.
+
+  Gene i of A has id i + 1 and gene j of B id |A| + j + 1 in the graph
+  (0 is the null extremity of telomeres). A forward gene has its tail
+  on the left, a reverse one its head.
+
+  Candidates are either the genes of the same family (family > 0), a
+  given list of weighted pairs or similarity hits between gene names
+  (see blast.hpp), the heaviest hit of each pair in either direction.
+  Families are bucketed with a counting sort and vertices are found
+  through an array indexed by extremity, so building takes O(n +
+  edges): no pair of genes is ever compared.
+  Given a thread pool, pairs are generated for ranges of genes of A
+  in parallel (each gene's pairs have a fixed place, by a prefix sum)
+  and edges are added with Graph::addEdges, so the graph is the same
+  as the one built by a single thread.
+*/
+
+#ifndef _ADJACENCY_GRAPH_HPP
+
+#define _ADJACENCY_GRAPH_HPP 1
+
+#include <vector>
+
+#include "graph.hpp"
+#include "thread-pool.hpp"
+#include "genome.hpp"
+#include "gene-matching.hpp"
+#include "name-index.hpp"
+#include "blast.hpp"
+
+
+
+/**************
+ ** GENE IDS **
+ **************/
+// Returns the adjacency graph id of gene i of genome A
+inline int geneIdA(int i) { return i + 1; }
+
+// Returns the adjacency graph id of gene j of genome B
+inline int geneIdB(const Genome &a, int j) { return a.getGenes() + j + 1; }
+
+
+/***********************
+ ** BUILDER FUNCTIONS **
+ ***********************/
+// Builds the adjacency graph of a and b joining genes of the same family
+Graph *buildAdjacencyGraph(const Genome &a, const Genome &b, ThreadPool *pool = NULL);
+
+// Builds the adjacency graph of a and b joining the given pairs, with
+// p.a a gene (index) of a, p.b a gene of b and p.weight the weight of
+// both edges
+Graph *buildAdjacencyGraph(const Genome &a, const Genome &b, const std::vector<GenePair> &pairs,
+                           ThreadPool *pool = NULL);
+
+// Builds the adjacency graph of a and b joining the genes with a
+// similarity hit, with names resolving the gene names of the hits
+Graph *buildAdjacencyGraph(const Genome &a, const Genome &b, const NameIndex &names,
+                           const std::vector<SimilarityEdge> &edges, ThreadPool *pool = NULL);
+
+
+#endif /* adjacency-graph.hpp  */
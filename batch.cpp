@@ -0,0 +1,202 @@
+/**
+   Copyright (C) 2016 Diego Rubert
+
+   This file is part of the O(k)-approximation algorithm implementation
+   for the DCJ distance on linear unichromosomal genomes in:
+
+   Diego P. Rubert, Pedro Feijão, Marília D. V. Braga, Jens Stoye and Fábio V. Martinez
+   A Linear Time Approximation Algorithm for the DCJ Distance for Genomes with Bounded Number of Duplicates
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdio>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <chrono>
+
+#include "graph.hpp"
+#include "genome.hpp"
+#include "decomposition.hpp"
+#include "packing-memo.hpp"
+#include "packing.hpp"
+#include "synteny.hpp"
+#include "adjacency-graph.hpp"
+#include "thread-pool.hpp"
+#include "result-cache.hpp"
+#include "batch.hpp"
+
+
+using std::vector;
+
+
+
+/*******************
+ ** AUX FUNCTIONS **
+ *******************/
+// Scratch of the pairs run by a thread
+struct BatchScratch {
+  Genome a, b;          // Collapsed genomes
+  SyntenyBlocks blocks; // Blocks of the last pair
+};
+
+
+
+/*************************
+ ** BATCHENGINE METHODS **
+ *************************/
+BatchEngine::BatchEngine(const vector<Genome> &genomes, ThreadPool *pool, int maxLen, int copyThreshold,
+                         bool collapse, PackingMemo *memo, ResultCache *cache) :
+  genomes(genomes),
+  pool(pool),
+  maxLen(maxLen),
+  copyThreshold(copyThreshold),
+  collapse(collapse),
+  memo(memo),
+  cache(cache),
+  hits(0),
+  scores(genomes.size() * genomes.size(), DCJScore()),
+  seconds(genomes.size() * genomes.size(), 0),
+  copies(genomes.size())
+{
+  for (size_t i = 0; i < genomes.size(); i++) {
+    copies[i].assign(genomes[i].getMaxFamily() + 1, 0);
+    for (int g = 0; g < genomes[i].getGenes(); g++)
+      copies[i][genomes[i].getGene(g).family]++;
+    if (cache)
+      hashes.push_back(genomeHash(genomes[i]));
+  }
+}
+
+double BatchEngine::cost(int i, int j) const
+{
+  const vector<int> &x = copies[i], &y = copies[j];
+  double c = genomes[i].getGenes() + genomes[j].getGenes();
+
+  for (size_t f = 1; f < x.size() && f < y.size(); f++)
+    c += (double) x[f] * y[f];
+  return c;
+}
+
+void BatchEngine::compare(int i, int j)
+{
+  static thread_local BatchScratch scratch;
+  auto start = std::chrono::steady_clock::now();
+  ResultKey key;
+  CachedResult cached;
+  DCJScore s;
+
+  if (cache)
+    key = resultKey(hashes[i], hashes[j], 0, ResultParams::packing(maxLen, copyThreshold, collapse, memo != NULL));
+  if (cache && cache->find(key, cached)) {
+    s = cached.score;
+    hits++;
+  }
+  else {
+    const Genome *a = &genomes[i], *b = &genomes[j];
+    if (collapse) {
+      scratch.blocks.collapse(*a, *b, scratch.a, scratch.b);
+      a = &scratch.a;
+      b = &scratch.b;
+    }
+    Graph *ag = buildAdjacencyGraph(*a, *b);
+
+    PackingEngine engine(ag, maxLen, memo, copyThreshold);
+    engine.run();
+    delete ag;
+
+    s = collapse ? scratch.blocks.expand(engine.getScore()) : engine.getScore();
+    if (cache) {
+      cached = CachedResult::summarize(engine, 0);
+      cached.score = s;
+      cached.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      cache->store(key, cached);
+    }
+  }
+
+  // cycles and paths are the same seen from B, only n (genes of A) changes
+  DCJScore r = s;
+  r.genes += genomes[j].getGenes() - genomes[i].getGenes();
+  r.distance = r.genes - r.cycles - r.oddPaths / 2;
+
+  double t = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  scores[i * getN() + j] = s;
+  scores[j * getN() + i] = r;
+  seconds[i * getN() + j] = seconds[j * getN() + i] = t;
+}
+
+void BatchEngine::run(void)
+{
+  vector<std::pair<double, std::pair<int, int>>> pairs;
+
+  for (int i = 0; i < getN(); i++)
+    for (int j = i + 1; j < getN(); j++)
+      pairs.push_back(std::make_pair(cost(i, j), std::make_pair(i, j)));
+  std::sort(pairs.begin(), pairs.end(), [](const std::pair<double, std::pair<int, int>> &x,
+                                           const std::pair<double, std::pair<int, int>> &y) {
+      return x.first != y.first ? x.first > y.first : x.second < y.second;
+    });
+
+  if (pool == NULL) {
+    for (auto &p : pairs)
+      compare(p.second.first, p.second.second);
+    return;
+  }
+
+  for (auto &p : pairs) { // run in submission order, so longest first
+    int i = p.second.first, j = p.second.second;
+    pool->submit([this, i, j]() { compare(i, j); });
+  }
+  pool->wait();
+}
+
+bool BatchEngine::writeMatrix(const char *path, bool similarity) const
+{
+  FILE *f = fopen(path, "w");
+
+  if (f == NULL)
+    return false;
+
+  fprintf(f, "%d\n", getN());
+  for (int i = 0; i < getN(); i++) {
+    const char *name = genomes[i].getName();
+    if (*name)
+      fprintf(f, "%s", name);
+    else
+      fprintf(f, "genome%d", i + 1);
+    for (int j = 0; j < getN(); j++) {
+      if (similarity)
+        fprintf(f, " %g", i == j ? 0.0 : getScore(i, j).similarity);
+      else
+        fprintf(f, " %d", i == j ? 0 : getScore(i, j).distance);
+    }
+    fprintf(f, "\n");
+  }
+
+  return fclose(f) == 0;
+}
+
+void BatchEngine::print(void) const
+{
+  double total = 0, longest = 0;
+
+  for (int i = 0; i < getN(); i++)
+    for (int j = i + 1; j < getN(); j++) {
+      total += getSeconds(i, j);
+      longest = std::max(longest, getSeconds(i, j));
+    }
+  printf("%d genomes, %d pairs compared (%d cached), %.3fs in pairs (longest %.3fs)\n",
+         getN(), getN() * (getN() - 1) / 2, (int) hits, total, longest);
+}
@@ -0,0 +1,112 @@
+/**
+   Copyright (C) 2016 Diego Rubert
+
+   This file is part of the O(k)-approximation algorithm implementation
+   for the DCJ distance on linear unichromosomal genomes in:
+
+   Diego P. Rubert, Pedro Feijão, Marília D. V. Braga, Jens Stoye and Fábio V. Martinez
+   A Linear Time Approximation Algorithm for the DCJ Distance for Genomes with Bounded Number of Duplicates
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+  All-vs-all comparison of a set of genomes loaded once. Each of the
+  N(N-1)/2 pairs is a task on a shared thread pool that builds the
+  adjacency graph (after collapsing conserved synteny blocks, see
+  synteny.hpp, if asked), runs the packing engine and scores the
+  decomposition. Tasks are submitted longest expected first, the
+  expected cost of a pair being its number of genes plus its number
+  of candidate pairs (sum over families of the product of the copies
+  in each genome), computed from per-genome family counts, so the
+  largest pairs don't end up alone at the end. Scratch data of a pair
+  (collapsed genomes, synteny blocks) is kept per thread and reused by
+  the next pair the thread runs. Engines may share a PackingMemo, and
+  pairs found in a ResultCache (see result-cache.hpp) aren't run.
+*/
+
+#ifndef _BATCH_HPP
+
+#define _BATCH_HPP 1
+
+#include <cstdint>
+#include <vector>
+#include <atomic>
+
+#include "genome.hpp"
+#include "decomposition.hpp"
+#include "packing-memo.hpp"
+#include "thread-pool.hpp"
+#include "result-cache.hpp"
+
+
+
+/***********************
+ ** BATCHENGINE CLASS **
+ ***********************/
+class BatchEngine {
+private:
+  const std::vector<Genome> &genomes; // Genomes compared
+  ThreadPool *pool;                   // Runs the pairs (NULL = calling thread)
+  int maxLen;                         // Length of cycles in the last round (0 = 2k)
+  int copyThreshold;                  // High-copy fallback threshold (0 = none)
+  bool collapse;                      // Whether synteny blocks are collapsed
+  PackingMemo *memo;                  // Memo shared by all engines (NULL = none)
+  ResultCache *cache;                 // Results of earlier runs (NULL = none)
+  std::atomic<int> hits;              // Pairs found in the cache
+  std::vector<uint64_t> hashes;       // Content hash of each genome (with a cache)
+  std::vector<DCJScore> scores;       // Scores of each pair, row major
+  std::vector<double> seconds;        // Time taken by each pair, row major
+  std::vector<std::vector<int>> copies; // Copies of each family in each genome
+
+  // Compares genomes i and j
+  void compare(int i, int j);
+
+  // Returns the expected cost of comparing genomes i and j
+  double cost(int i, int j) const;
+
+public:
+  // Receives the genomes (which must outlive the engine), a pool, the
+  // options of every pair's packing engine and optionally a cache of
+  // results (looked up before, and filled after, running a pair)
+  BatchEngine(const std::vector<Genome> &genomes, ThreadPool *pool, int maxLen = 0, int copyThreshold = 0,
+              bool collapse = true, PackingMemo *memo = NULL, ResultCache *cache = NULL);
+
+  // Compares every pair of genomes
+  void run(void);
+
+  // Returns the number of genomes
+  inline int getN(void) const { return (int) genomes.size(); }
+
+  // Returns the scores of the pair i, j with genome i as A (the
+  // distance depends on the genes of A, both are taken from one run)
+  inline const DCJScore &getScore(int i, int j) const { return scores[i * getN() + j]; }
+
+  // Returns the number of pairs found in the cache
+  inline int getHits(void) const { return hits; }
+
+  // Returns the time taken by the pair i, j in seconds
+  inline double getSeconds(int i, int j) const { return seconds[i * getN() + j]; }
+
+  // Writes the distance (or similarity) matrix in PHYLIP square
+  // format, row i holding the scores with genome i as A, returns
+  // false on error
+  bool writeMatrix(const char *path, bool similarity = false) const;
+
+  // Prints a summary
+  void print(void) const;
+};
+
+
+#endif /* batch.hpp  */
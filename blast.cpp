@@ -0,0 +1,232 @@
+/**
+   Copyright (C) 2016 Diego Rubert
+
+   This file is part of the O(k)-approximation algorithm implementation
+   for the DCJ distance on linear unichromosomal genomes in:
+
+   Diego P. Rubert, Pedro Feijão, Marília D. V. Braga, Jens Stoye and Fábio V. Martinez
+   A Linear Time Approximation Algorithm for the DCJ Distance for Genomes with Bounded Number of Duplicates
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+#include "name-index.hpp"
+#include "input-file.hpp"
+#include "thread-pool.hpp"
+#include "blast.hpp"
+
+
+using std::vector;
+
+
+
+/*******************
+ ** AUX FUNCTIONS **
+ *******************/
+// Converts [p, end) to a number (sign, digits, fraction, exponent),
+// returns false unless the whole range is a number
+static bool parseNumber(const char *p, const char *end, double &x)
+{
+  static const double pow10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+                                 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+  bool negative = false, digits = false;
+  int exp = 0;
+
+  x = 0;
+  if (p < end && (*p == '-' || *p == '+'))
+    negative = *p++ == '-';
+  for (; p < end && *p >= '0' && *p <= '9'; p++, digits = true)
+    x = 10 * x + (*p - '0');
+  if (p < end && *p == '.')
+    for (p++; p < end && *p >= '0' && *p <= '9'; p++, digits = true) {
+      x = 10 * x + (*p - '0');
+      exp--;
+    }
+  if (!digits)
+    return false;
+
+  if (p < end && (*p == 'e' || *p == 'E')) {
+    bool minus = false;
+    int e = 0;
+    if (++p < end && (*p == '-' || *p == '+'))
+      minus = *p++ == '-';
+    if (p == end)
+      return false;
+    for (; p < end && *p >= '0' && *p <= '9'; p++)
+      e = e < 10000 ? 10 * e + (*p - '0') : e;
+    exp += minus ? -e : e;
+  }
+  if (p != end)
+    return false;
+
+  if (exp != 0 && x != 0) {
+    double scale = exp >= -22 && exp <= 22 ? pow10[exp < 0 ? -exp : exp] : pow(10.0, exp < 0 ? -exp : exp);
+    x = exp < 0 ? x / scale : x * scale;
+  }
+  if (negative)
+    x = -x;
+  return true;
+}
+
+
+
+/**************************
+ ** BLASTOPTIONS METHODS **
+ **************************/
+BlastOptions::BlastOptions(void) :
+  minScore(-HUGE_VAL),
+  maxEvalue(HUGE_VAL),
+  minIdentity(-HUGE_VAL),
+  identity(false),
+  self(false)
+{
+}
+
+
+
+/*************************
+ ** BLASTPARSER METHODS **
+ *************************/
+BlastParser::BlastParser(NameIndex *names, const BlastOptions &options) :
+  names(names),
+  options(options),
+  lines(0),
+  kept(0),
+  malformed(0)
+{
+}
+
+void BlastParser::parse(const char *begin, const char *end, vector<SimilarityEdge> &edges)
+{
+  const char *field[13];
+
+  for (const char *p = begin, *eol; p < end; p = eol + 1) {
+    eol = (const char *) memchr(p, '\n', end - p);
+    if (eol == NULL)
+      eol = end;
+
+    const char *last = eol;
+    if (last > p && last[-1] == '\r')
+      last--;
+    if (last == p || *p == '#')
+      continue;
+    lines++;
+
+    // start of the first 12 fields (and the end of the 12th)
+    int k = 0;
+    field[k++] = p;
+    for (const char *q = p; k < 13; k++) {
+      q = (const char *) memchr(q, '\t', last - q);
+      if (q == NULL)
+        break;
+      field[k] = ++q;
+    }
+    if (k < 12) {
+      malformed++;
+      continue;
+    }
+    if (k == 12)
+      field[12] = last + 1;
+
+    double identity, evalue, score;
+    if (!parseNumber(field[2], field[3] - 1, identity) || !parseNumber(field[10], field[11] - 1, evalue) ||
+        !parseNumber(field[11], field[12] - 1, score)) {
+      malformed++;
+      continue;
+    }
+
+    if (score < options.minScore || evalue > options.maxEvalue || identity < options.minIdentity)
+      continue;
+
+    size_t la = field[1] - 1 - field[0], lb = field[2] - 1 - field[1];
+    if (!options.self && la == lb && memcmp(field[0], field[1], la) == 0)
+      continue;
+
+    int a = names->insert(field[0], la), b = names->insert(field[1], lb);
+    edges.push_back(SimilarityEdge{a, b, options.identity ? identity / 100 : score});
+    kept++;
+  }
+}
+
+void BlastParser::parse(const char *begin, const char *end, vector<SimilarityEdge> &edges, ThreadPool *pool, size_t chunkSize)
+{
+  size_t length = end - begin;
+  vector<const char *> cut(1, begin);
+
+  if (pool == NULL || pool->size() == 0 || length == 0) {
+    parse(begin, end, edges);
+    return;
+  }
+
+  if (chunkSize == 0)
+    chunkSize = std::max(length / (4 * (pool->size() + 1)) + 1, (size_t) 1 << 20);
+  while (cut.back() < end) { // chunks end right after a newline
+    const char *p = cut.back() + std::min(chunkSize, (size_t) (end - cut.back()));
+    const char *eol = p < end ? (const char *) memchr(p, '\n', end - p) : NULL;
+    cut.push_back(eol ? eol + 1 : end);
+  }
+
+  int chunks = (int) cut.size() - 1;
+  vector<NameIndex> local(chunks, NameIndex(1024));
+  vector<vector<SimilarityEdge>> buffer(chunks);
+  vector<BlastParser> parser(chunks, BlastParser(NULL, options));
+
+  pool->parallelFor(0, chunks, [&](long from, long to, long) {
+      for (long k = from; k < to; k++) {
+        parser[k].names = &local[k];
+        parser[k].parse(cut[k], cut[k+1], buffer[k]);
+      }
+    }, 1);
+
+  // merge in chunk order, translating local name ids
+  size_t total = edges.size();
+  for (int k = 0; k < chunks; k++)
+    total += buffer[k].size();
+  edges.reserve(total);
+
+  vector<int> id;
+  for (int k = 0; k < chunks; k++) {
+    id.resize(local[k].size());
+    for (int x = 0; x < local[k].size(); x++)
+      id[x] = names->insert(local[k].name(x));
+    for (auto &e : buffer[k])
+      edges.push_back(SimilarityEdge{id[e.a], id[e.b], e.weight});
+
+    lines += parser[k].lines;
+    kept += parser[k].kept;
+    malformed += parser[k].malformed;
+    vector<SimilarityEdge>().swap(buffer[k]);
+  }
+}
+
+bool BlastParser::parseFile(const char *path, vector<SimilarityEdge> &edges, ThreadPool *pool)
+{
+  InputFile file;
+
+  if (!file.open(path))
+    return false;
+
+  return file.read([&](const char *begin, const char *end) { parse(begin, end, edges, pool); }, pool);
+}
+
+void BlastParser::print(void) const
+{
+  printf("%ld hits read, %ld kept, %ld malformed lines\n", lines, kept, malformed);
+}
@@ -0,0 +1,119 @@
+/**
+   Copyright (C) 2016 Diego Rubert
+
+   This file is part of the O(k)-approximation algorithm implementation
+   for the DCJ distance on linear unichromosomal genomes in:
+
+   Diego P. Rubert, Pedro Feijão, Marília D. V. Braga, Jens Stoye and Fábio V. Martinez
+   A Linear Time Approximation Algorithm for the DCJ Distance for Genomes with Bounded Number of Duplicates
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+  Parser of BLAST tabular hits (-outfmt 6: query, subject, % identity,
+  length, mismatches, gap opens, query start/end, subject start/end,
+  e-value, bit score), the gene similarities of family-free inputs.
+  Plain files are memory mapped (compressed ones decompressed, see
+  input-file.hpp) and tokenized in place: fields are (pointer, length)
+  ranges, numbers are converted without copies and names are resolved
+  through a NameIndex, so only names seen for the first time are ever
+  copied. Hits failing the filters are dropped while reading
+  and every kept hit becomes a weighted SimilarityEdge between name
+  ids. Comment (#) and empty lines are skipped, malformed lines are
+  counted and skipped.
+
+  Large inputs may be parsed on a thread pool: the range is split at
+  line boundaries into chunks, each one parsed with its own NameIndex
+  into its own edge buffer, and the buffers are merged in chunk order
+  (names are added to the shared index in order of first appearance),
+  so ids and edges are exactly those of a sequential parse.
+*/
+
+#ifndef _BLAST_HPP
+
+#define _BLAST_HPP 1
+
+#include <vector>
+
+#include "name-index.hpp"
+#include "thread-pool.hpp"
+
+
+
+/**************************
+ ** SIMILARITYEDGE CLASS **
+ **************************/
+// A similarity hit between two genes (NameIndex ids)
+struct SimilarityEdge {
+  int a;         // Query gene
+  int b;         // Subject gene
+  double weight; // Similarity (bit score or identity)
+};
+
+
+/************************
+ ** BLASTOPTIONS CLASS **
+ ************************/
+// Filters applied while reading and choice of edge weights
+struct BlastOptions {
+  double minScore;     // Smallest bit score kept
+  double maxEvalue;    // Largest e-value kept
+  double minIdentity;  // Smallest % identity kept
+  bool identity;       // Weights are identity / 100 instead of bit scores
+  bool self;           // Keep hits of a gene to itself
+
+  // Keeps everything but self hits, weights are bit scores
+  BlastOptions(void);
+};
+
+
+/***********************
+ ** BLASTPARSER CLASS **
+ ***********************/
+class BlastParser {
+private:
+  NameIndex *names;     // Ids of gene names
+  BlastOptions options; // Filters
+  long lines;           // Hit lines read
+  long kept;            // Hits kept
+  long malformed;       // Lines skipped for lack of fields or bad numbers
+
+public:
+  // Receives the index gene names are resolved with and the filters
+  BlastParser(NameIndex *names, const BlastOptions &options = BlastOptions());
+
+  // Parses the lines in [begin, end), appending the kept hits to edges
+  void parse(const char *begin, const char *end, std::vector<SimilarityEdge> &edges);
+
+  // Same as above, in chunks of about chunkSize bytes (0 = a few per
+  // thread, at least 1 MB) parsed on pool
+  void parse(const char *begin, const char *end, std::vector<SimilarityEdge> &edges,
+             ThreadPool *pool, size_t chunkSize = 0);
+
+  // Reads (see input-file.hpp, gzip/BGZF are decompressed) and parses
+  // a whole file, on pool if any, returns false if it can't be read
+  bool parseFile(const char *path, std::vector<SimilarityEdge> &edges, ThreadPool *pool = NULL);
+
+  // Returns the number of hit lines read, kept and malformed
+  inline long getLines(void) const { return lines; }
+  inline long getKept(void) const { return kept; }
+  inline long getMalformed(void) const { return malformed; }
+
+  // Prints a summary
+  void print(void) const;
+};
+
+
+#endif /* blast.hpp  */
@@ -0,0 +1,276 @@
+/**
+   Copyright (C) 2016 Diego Rubert
+
+   This file is part of the O(k)-approximation algorithm implementation
+   for the DCJ distance on linear unichromosomal genomes in:
+
+   Diego P. Rubert, Pedro Feijão, Marília D. V. Braga, Jens Stoye and Fábio V. Martinez
+   A Linear Time Approximation Algorithm for the DCJ Distance for Genomes with Bounded Number of Duplicates
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+#include "graph.hpp"
+#include "paths-cycles.hpp"
+#include "conflict-graph.hpp"
+#include "solvers.hpp"
+#include "bounds.hpp"
+
+
+using std::vector;
+
+
+
+/*******************
+ ** AUX FUNCTIONS **
+ *******************/
+// Grows a clique inside candidates (all not yet covered) starting at
+// candidates[0]. Vertices that don't fit are returned in rest. Uses
+// mark/cnt as scratch: cnt[x] counts clique members adjacent to x
+static void growClique(const ConflictGraph *g, const vector<int> &candidates, vector<int> &rest, int q,
+                       vector<int> &clique, vector<int> &mark, vector<int> &cnt)
+{
+  int seed = candidates[0], size = 1;
+
+  clique[seed] = q;
+  for (const int *x = g->begin(seed); x != g->end(seed); x++) {
+    mark[*x] = q;
+    cnt[*x] = 1;
+  }
+
+  rest.clear();
+  for (unsigned i = 1; i < candidates.size(); i++) {
+    int x = candidates[i];
+    if (mark[x] == q && cnt[x] == size) { // x is adjacent to every member
+      clique[x] = q;
+      size++;
+      for (const int *y = g->begin(x); y != g->end(x); y++)
+        if (mark[*y] == q)
+          cnt[*y]++;
+    }
+    else
+      rest.push_back(x);
+  }
+}
+
+// Sum of the heaviest vertex weight in each clique
+static double coverValue(const ConflictGraph *g, const vector<int> &clique, int ncliques)
+{
+  vector<double> heaviest(ncliques, 0);
+  double total = 0;
+
+  for (int v = 0; v < g->getN(); v++)
+    heaviest[clique[v]] = std::max(heaviest[clique[v]], g->weight(v));
+  for (auto h : heaviest)
+    total += h;
+  return total;
+}
+
+
+
+/*********************
+ ** BOUND FUNCTIONS **
+ *********************/
+double cliqueCoverBound(const ConflictGraph *g, vector<int> &clique)
+{
+  int n = g->getN(), q = 0;
+  vector<int> order(n), mark(n, -1), cnt(n, 0), candidates, rest;
+
+  // vertices with larger degree first, they are in larger cliques
+  for (int v = 0; v < n; v++)
+    order[v] = v;
+  std::sort(order.begin(), order.end(), [g](int a, int b) { return g->degree(a) > g->degree(b); });
+
+  clique.assign(n, -1);
+  for (auto v : order) {
+    if (clique[v] >= 0)
+      continue;
+    candidates.clear();
+    candidates.push_back(v);
+    for (const int *u = g->begin(v); u != g->end(v); u++)
+      if (clique[*u] < 0)
+        candidates.push_back(*u);
+    growClique(g, candidates, rest, q++, clique, mark, cnt);
+  }
+
+  return coverValue(g, clique, q);
+}
+
+double bucketCoverBound(const ConflictGraph *g, vector<int> &clique)
+{
+  int n = g->getN(), q = 0, maxex = 0;
+  vector<int> mark(n, -1), cnt(n, 0), candidates, rest;
+
+  if (!g->hasCycles()) // no gene extremities to bucket by
+    return cliqueCoverBound(g, clique);
+
+  for (int v = 0; v < n; v++)
+    for (auto e : g->cycle(v)->getEdges()) {
+      maxex = std::max(maxex, e->getExtremityFrom().index() + 1);
+      maxex = std::max(maxex, e->getExtremityTo().index() + 1);
+    }
+
+  // bucket of each gene extremity: cycles using it
+  vector<vector<int>> buckets(maxex);
+  for (int v = 0; v < n; v++)
+    for (auto e : g->cycle(v)->getEdges()) {
+      int from = e->getExtremityFrom().index(), to = e->getExtremityTo().index();
+      if (from >= 0)
+        buckets[from].push_back(v);
+      if (to >= 0)
+        buckets[to].push_back(v);
+    }
+
+  vector<int> order(maxex);
+  for (int b = 0; b < maxex; b++)
+    order[b] = b;
+  std::sort(order.begin(), order.end(), [&buckets](int a, int b) { return buckets[a].size() > buckets[b].size(); });
+
+  // each clique is seeded by an uncovered cycle in the bucket and tries
+  // the other cycles of the bucket first, then the seed's other neighbors
+  clique.assign(n, -1);
+  vector<int> inBucket(n, -1);
+  for (auto b : order) {
+    for (auto v : buckets[b])
+      inBucket[v] = b;
+
+    for (auto seed : buckets[b]) {
+      if (clique[seed] >= 0)
+        continue; // usually all but the first, the bucket is a clique
+
+      candidates.clear();
+      candidates.push_back(seed);
+      for (auto v : buckets[b])
+        if (v != seed && clique[v] < 0)
+          candidates.push_back(v);
+      for (const int *u = g->begin(seed); u != g->end(seed); u++)
+        if (inBucket[*u] != b && clique[*u] < 0)
+          candidates.push_back(*u);
+      growClique(g, candidates, rest, q++, clique, mark, cnt);
+    }
+  }
+
+  for (int v = 0; v < n; v++) // cycles without gene extremities (if any)
+    if (clique[v] < 0)
+      clique[v] = q++;
+
+  return coverValue(g, clique, q);
+}
+
+double fractionalBound(const ConflictGraph *g, const vector<int> &clique1, const vector<int> &clique2,
+                       double lower, int iterations)
+{
+  int n = g->getN(), q1 = 0, q2 = 0;
+  double best, mu = 1.0;
+  int stalled = 0;
+
+  if (n == 0)
+    return 0;
+
+  for (int v = 0; v < n; v++) {
+    q1 = std::max(q1, clique1[v] + 1);
+    q2 = std::max(q2, clique2[v] + 1);
+  }
+
+  // start at the multipliers of the best cover (the other one is zeroed)
+  vector<double> lambda1(q1, 0), lambda2(q2, 0), g1(q1), g2(q2);
+  double c1 = coverValue(g, clique1, q1), c2 = coverValue(g, clique2, q2);
+  for (int v = 0; v < n; v++) {
+    if (c1 <= c2)
+      lambda1[clique1[v]] = std::max(lambda1[clique1[v]], g->weight(v));
+    else
+      lambda2[clique2[v]] = std::max(lambda2[clique2[v]], g->weight(v));
+  }
+  best = std::min(c1, c2);
+
+  for (int it = 0; it < iterations; it++) {
+    double dual = 0, norm = 0;
+
+    // dual value and subgradient (1 - sum of x_v over each clique)
+    for (auto l : lambda1) dual += l;
+    for (auto l : lambda2) dual += l;
+    std::fill(g1.begin(), g1.end(), 1.0);
+    std::fill(g2.begin(), g2.end(), 1.0);
+    for (int v = 0; v < n; v++) {
+      double reduced = g->weight(v) - lambda1[clique1[v]] - lambda2[clique2[v]];
+      if (reduced > 0) {
+        dual += reduced;
+        g1[clique1[v]] -= 1;
+        g2[clique2[v]] -= 1;
+      }
+    }
+
+    if (dual < best - 1e-9) {
+      best = dual;
+      stalled = 0;
+    }
+    else if (++stalled >= 5) { // shrink step when not improving
+      mu /= 2;
+      stalled = 0;
+    }
+
+    for (auto x : g1) norm += x * x;
+    for (auto x : g2) norm += x * x;
+    if (norm == 0 || dual - lower < 1e-9 || mu < 1e-4) // optimal or converged
+      break;
+
+    double t = mu * (dual - lower) / norm; // Polyak step
+    for (int q = 0; q < q1; q++)
+      lambda1[q] = std::max(0.0, lambda1[q] - t * g1[q]);
+    for (int q = 0; q < q2; q++)
+      lambda2[q] = std::max(0.0, lambda2[q] - t * g2[q]);
+  }
+
+  return best;
+}
+
+
+
+/**************************
+ ** PACKINGBOUND METHODS **
+ **************************/
+PackingBound::PackingBound(const ConflictGraph *g, double lower, int iterations) :
+  integral(true)
+{
+  vector<int> clique1, clique2;
+
+  for (int v = 0; v < g->getN(); v++)
+    if (g->weight(v) != std::floor(g->weight(v)))
+      integral = false;
+
+  if (lower < 0)
+    lower = g->weight(greedyPacking(g));
+
+  clique = cliqueCoverBound(g, clique1);
+  bucket = bucketCoverBound(g, clique2);
+  fractional = fractionalBound(g, clique1, clique2, lower, iterations);
+}
+
+double PackingBound::best(void) const
+{
+  double b = std::min(std::min(clique, bucket), fractional);
+  return integral ? std::floor(b + 1e-9) : b;
+}
+
+double PackingBound::gap(double value) const
+{
+  double b = best();
+  if (b <= 0)
+    return 0;
+  return std::max(0.0, (b - value) / b);
+}
@@ -0,0 +1,108 @@
+/**
+   Copyright (C) 2016 Diego Rubert
+
+   This file is part of the O(k)-approximation algorithm implementation
+   for the DCJ distance on linear unichromosomal genomes in:
+
+   Diego P. Rubert, Pedro Feijão, Marília D. V. Braga, Jens Stoye and Fábio V. Martinez
+   A Linear Time Approximation Algorithm for the DCJ Distance for Genomes with Bounded Number of Duplicates
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+  Cheap upper bounds on the value of a cycle packing, i.e. on the
+  weight of a maximum independent set of the conflict graph. Any
+  solver can compare its incumbent against these bounds and stop as
+  soon as the gap closes. Three bounds are computed:
+
+  * Greedy clique cover: vertices are partitioned into cliques, and
+    an independent set picks at most one vertex from each clique
+  * Gene bucket cover: cycles using the same gene extremity are
+    grouped (they almost always form a clique, since two different
+    cycles through the same extremity diverge somewhere), and each
+    group is split into actual cliques
+  * Fractional relaxation: LP with the clique constraints of both
+    covers, whose Lagrangian dual is minimized by subgradient
+    descent. It starts from the best cover, so it is never worse
+*/
+
+#ifndef _BOUNDS_HPP
+
+#define _BOUNDS_HPP 1
+
+#include <vector>
+
+#include "conflict-graph.hpp"
+
+
+
+/*********************
+ ** BOUND FUNCTIONS **
+ *********************/
+// Greedy clique cover (vertices in decreasing degree order), O(n + m).
+// Fills clique with the clique index of each vertex and returns the
+// sum of the heaviest vertex of each clique
+double cliqueCoverBound(const ConflictGraph *g, std::vector<int> &clique);
+
+// Clique cover seeded by gene extremity buckets (cycles sharing some
+// gene extremity), same output as cliqueCoverBound (which is used
+// instead if vertices are not cycles)
+double bucketCoverBound(const ConflictGraph *g, std::vector<int> &clique);
+
+// Lagrangian relaxation of the LP with the constraints of the two
+// clique covers given, minimized by subgradient descent with Polyak
+// steps towards lower (value of some known solution). Returns the
+// smallest dual value found, which is a valid upper bound
+double fractionalBound(const ConflictGraph *g, const std::vector<int> &clique1, const std::vector<int> &clique2,
+                       double lower = 0, int iterations = 100);
+
+
+/************************
+ ** PACKINGBOUND CLASS **
+ ************************/
+// Computes all bounds once and answers gap queries for a solver
+class PackingBound {
+private:
+  double clique;     // Greedy clique cover bound
+  double bucket;     // Gene bucket cover bound
+  double fractional; // Fractional relaxation bound
+  bool integral;     // True if all weights are integers (so is the optimum)
+
+public:
+  // Computes the bounds. The value of a known solution (lower) helps
+  // the subgradient method, it is computed greedily if not given
+  PackingBound(const ConflictGraph *g, double lower = -1, int iterations = 100);
+
+  // Returns the greedy clique cover bound
+  inline double getCliqueCover(void) const { return clique; }
+
+  // Returns the gene bucket cover bound
+  inline double getBucketCover(void) const { return bucket; }
+
+  // Returns the fractional relaxation bound
+  inline double getFractional(void) const { return fractional; }
+
+  // Returns the best (smallest) bound, rounded down if weights are integers
+  double best(void) const;
+
+  // Returns the relative gap (best - value) / best of a solution value
+  double gap(double value) const;
+
+  // Returns true if a solution with this value is provably optimal
+  inline bool closed(double value) const { return value >= best() - 1e-9; }
+};
+
+
+#endif /* bounds.hpp  */
@@ -0,0 +1,333 @@
+/**
+   Copyright (C) 2016 Diego Rubert
+
+   This file is part of the O(k)-approximation algorithm implementation
+   for the DCJ distance on linear unichromosomal genomes in:
+
+   Diego P. Rubert, Pedro Feijão, Marília D. V. Braga, Jens Stoye and Fábio V. Martinez
+   A Linear Time Approximation Algorithm for the DCJ Distance for Genomes with Bounded Number of Duplicates
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdio>
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+#include <mutex>
+#include <chrono>
+
+#include "conflict-graph.hpp"
+#include "solvers.hpp"
+#include "local-search.hpp"
+#include "thread-pool.hpp"
+#include "components.hpp"
+
+
+using std::vector;
+
+
+
+/*******************
+ ** AUX FUNCTIONS **
+ *******************/
+// Heaviest independent subset of mask (bit i = vertex i), given the
+// closed neighborhood of each vertex as a mask, by exhaustive search.
+// Vertices without neighbors in mask are taken without branching, and
+// the search branches on a vertex of highest degree, whose removal
+// shrinks the mask the most
+static double tinySearch(uint32_t mask, const vector<uint32_t> &closed, const vector<double> &w, uint32_t &chosen)
+{
+  uint32_t alone = 0;
+  double sum = 0;
+  int v = -1, most = 0;
+
+  for (uint32_t m = mask; m; m &= m - 1) {
+    int u = __builtin_ctz(m), degree = __builtin_popcount(closed[u] & mask) - 1;
+    if (degree == 0 && w[u] >= 0) {
+      alone |= 1u << u;
+      sum += w[u];
+    }
+    else if (v < 0 || degree > most) {
+      v = u;
+      most = degree;
+    }
+  }
+
+  if (v < 0) {
+    chosen = alone;
+    return sum;
+  }
+
+  mask &= ~alone;
+  uint32_t with, without;
+  double in = w[v] + tinySearch(mask & ~closed[v], closed, w, with);
+  double out = tinySearch(mask & ~(1u << v), closed, w, without);
+
+  if (in >= out) {
+    chosen = alone | with | (1u << v);
+    return sum + in;
+  }
+  chosen = alone | without;
+  return sum + out;
+}
+
+
+
+/*************************
+ ** COMPONENT FUNCTIONS **
+ *************************/
+int conflictComponents(const ConflictGraph *g, vector<int> &comp)
+{
+  int n = g->getN(), count = 0;
+  vector<int> stack;
+
+  comp.assign(n, -1);
+  for (int s = 0; s < n; s++) {
+    if (comp[s] >= 0)
+      continue;
+    comp[s] = count;
+    stack.push_back(s);
+    while (!stack.empty()) {
+      int v = stack.back();
+      stack.pop_back();
+      for (const int *u = g->begin(v); u != g->end(v); u++)
+        if (comp[*u] < 0) {
+          comp[*u] = count;
+          stack.push_back(*u);
+        }
+    }
+    count++;
+  }
+
+  return count;
+}
+
+ConflictGraph *inducedGraph(const ConflictGraph *g, const vector<int> &vertices, const vector<int> &local)
+{
+  int n = (int) vertices.size();
+  vector<int> off(n + 1, 0), adj;
+  vector<double> w(n);
+
+  for (int i = 0; i < n; i++) {
+    int v = vertices[i];
+    for (const int *u = g->begin(v); u != g->end(v); u++) {
+      int j = local[*u];
+      if (j >= 0 && j < n && vertices[j] == *u)
+        adj.push_back(j);
+    }
+    off[i+1] = (int) adj.size();
+    w[i] = g->weight(v);
+  }
+
+  return new ConflictGraph(off, adj, w);
+}
+
+
+
+/*****************************
+ ** COMPONENTSOLVER METHODS **
+ *****************************/
+ComponentSolver::ComponentSolver(const ConflictGraph *g, ThreadPool *pool, int tinyLimit, int mediumLimit, double mediumDensity) :
+  g(g),
+  pool(pool),
+  tinyLimit(std::min(tinyLimit, 30)), // bit masks
+  mediumLimit(mediumLimit),
+  mediumDensity(mediumDensity),
+  running(0),
+  cancel(false),
+  left(0),
+  deadline(0)
+{
+  int n = g->getN();
+  vector<int> comp;
+
+  // vertices of each component (counting sort)
+  count = conflictComponents(g, comp);
+  first.assign(count + 1, 0);
+  for (int v = 0; v < n; v++)
+    first[comp[v] + 1]++;
+  for (int c = 0; c < count; c++)
+    first[c+1] += first[c];
+  members.resize(n);
+  local.resize(n);
+  vector<int> pos(first.begin(), first.end() - 1);
+  for (int v = 0; v < n; v++) {
+    local[v] = pos[comp[v]] - first[comp[v]];
+    members[pos[comp[v]]++] = v;
+  }
+
+  classes.resize(count);
+  for (int c = 0; c < count; c++) {
+    long size = getSize(c), m = 0;
+    for (int i = first[c]; i < first[c+1]; i++)
+      m += g->degree(members[i]);
+    double density = size > 1 ? (double) m / (size * (size - 1)) : 1;
+
+    if (size <= this->tinyLimit)
+      classes[c] = TINY;
+    else if (size <= mediumLimit && (density >= mediumDensity || size <= mediumLimit / 4))
+      classes[c] = MEDIUM;
+    else
+      classes[c] = LARGE;
+  }
+}
+
+double ComponentSolver::elapsed(void) const
+{
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void ComponentSolver::solveTiny(int c)
+{
+  int size = getSize(c);
+  const int *vertices = members.data() + first[c];
+  vector<uint32_t> closed(size, 0);
+  vector<double> w(size);
+  uint32_t chosen;
+
+  for (int i = 0; i < size; i++) {
+    closed[i] = 1u << i;
+    w[i] = g->weight(vertices[i]);
+    for (const int *u = g->begin(vertices[i]); u != g->end(vertices[i]); u++)
+      closed[i] |= 1u << local[*u]; // same component
+  }
+
+  tinySearch((1u << size) - 1, closed, w, chosen);
+
+  solution[c].clear();
+  for (int i = 0; i < size; i++)
+    if (chosen >> i & 1)
+      solution[c].push_back(vertices[i]);
+  exact[c] = 1;
+}
+
+void ComponentSolver::solveMedium(int c)
+{
+  vector<int> vertices(members.begin() + first[c], members.begin() + first[c+1]);
+  ConflictGraph *sub = inducedGraph(g, vertices, local);
+  vector<int> s = greedyPacking(sub);
+
+  left -= sub->getN();
+  exact[c] = exactPacking(sub, s, &cancel);
+  solution[c].clear();
+  for (auto i : s)
+    solution[c].push_back(vertices[i]);
+  delete sub;
+}
+
+void ComponentSolver::solveLarge(int c)
+{
+  vector<int> vertices(members.begin() + first[c], members.begin() + first[c+1]);
+  ConflictGraph *sub = inducedGraph(g, vertices, local);
+  int size = sub->getN();
+
+  // this component's share of the remaining time (medium ones not
+  // started count too, with few threads they run after this one)
+  double budget = std::max(0.0, deadline - elapsed()) * size / left.fetch_sub(size);
+
+  LocalSearch search(NULL, sub, c + 1);
+  search.init(lubyPacking(sub, pool, c + 1, true));
+  search.run(budget);
+
+  exact[c] = search.getBound().closed(search.getBestValue());
+  solution[c].clear();
+  for (auto i : search.getBest())
+    solution[c].push_back(vertices[i]);
+  delete sub;
+}
+
+vector<int> ComponentSolver::run(double seconds)
+{
+  vector<int> order, tiny, merged;
+
+  solution.assign(count, vector<int>());
+  exact.assign(count, 0);
+  cancel = false;
+  start = std::chrono::steady_clock::now();
+  deadline = seconds;
+
+  left = 0;
+  for (int c = 0; c < count; c++)
+    if (classes[c] == TINY)
+      tiny.push_back(c);
+    else {
+      order.push_back(c);
+      left += getSize(c);
+    }
+  std::stable_sort(order.begin(), order.end(), [this](int a, int b) { return getSize(a) > getSize(b); });
+
+  running = (int) order.size() + 1;
+  auto done = [this]() {
+    std::lock_guard<std::mutex> guard(lock);
+    running--;
+    finished.notify_all();
+  };
+
+  for (auto c : order)
+    pool->submit([this, c, done]() {
+        if (classes[c] == MEDIUM)
+          solveMedium(c);
+        else
+          solveLarge(c);
+        done();
+      });
+
+  pool->submit([this, &tiny, done]() {
+      pool->parallelFor(0, tiny.size(), [this, &tiny](long from, long to, long) {
+          for (long i = from; i < to; i++)
+            solveTiny(tiny[i]);
+        });
+      done();
+    });
+
+  {
+    std::unique_lock<std::mutex> guard(lock);
+    auto until = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(seconds));
+    if (!finished.wait_until(guard, until, [this]() { return running == 0; })) {
+      cancel = true; // medium ones return their best, large ones are out of time already
+      finished.wait(guard, [this]() { return running == 0; });
+    }
+  }
+
+  for (int c = 0; c < count; c++)
+    merged.insert(merged.end(), solution[c].begin(), solution[c].end());
+  return merged;
+}
+
+int ComponentSolver::countClass(Class k) const
+{
+  return (int) std::count(classes.begin(), classes.end(), k);
+}
+
+bool ComponentSolver::optimal(void) const
+{
+  return std::find(exact.begin(), exact.end(), 0) == exact.end();
+}
+
+void ComponentSolver::print(void) const
+{
+  static const char *names[] = {"tiny", "medium", "large"};
+
+  for (int k = TINY; k <= LARGE; k++) {
+    int total = 0, solved = 0, largest = 0;
+    for (int c = 0; c < count; c++)
+      if (classes[c] == k) {
+        total++;
+        solved += c < (int) exact.size() && exact[c];
+        largest = std::max(largest, getSize(c));
+      }
+    printf("%-6s components: %d, largest: %d, solved exactly: %d\n", names[k], total, largest, solved);
+  }
+}
@@ -0,0 +1,137 @@
+/**
+   Copyright (C) 2016 Diego Rubert
+
+   This file is part of the O(k)-approximation algorithm implementation
+   for the DCJ distance on linear unichromosomal genomes in:
+
+   Diego P. Rubert, Pedro Feijão, Marília D. V. Braga, Jens Stoye and Fábio V. Martinez
+   A Linear Time Approximation Algorithm for the DCJ Distance for Genomes with Bounded Number of Duplicates
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+  Per-component packing: the conflict graph is split in connected
+  components, which are solved independently and merged. Each one is
+  classified by vertex count and density and routed to the cheapest
+  adequate solver:
+  * tiny (at most tinyLimit vertices): exhaustive search on bit masks
+  * medium (at most mediumLimit vertices and dense enough, or at most
+    a quarter of mediumLimit): exact branch and bound on bitsets
+    (exactPacking), the clique cover bound is only tight on dense graphs
+  * large (everything else): weighted Luby refined by local search,
+    with time split proportionally to their sizes (and those of medium
+    ones not started)
+  Medium and large components run concurrently on a thread pool, largest
+  first, and tiny ones in a parallel loop after them.
+*/
+
+#ifndef _COMPONENTS_HPP
+
+#define _COMPONENTS_HPP 1
+
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+
+#include "conflict-graph.hpp"
+#include "thread-pool.hpp"
+
+
+
+/*************************
+ ** COMPONENT FUNCTIONS **
+ *************************/
+// Fills comp with the connected component of each vertex of g
+// (numbered in order of their smallest vertex), returns their count
+int conflictComponents(const ConflictGraph *g, std::vector<int> &comp);
+
+// Returns the subgraph of g induced by vertices (i-th vertex of the
+// result is vertices[i]). local[v] must be the position of v in
+// vertices for every v in it; a neighbor u is outside the subgraph if
+// local[u] is not a position holding u
+ConflictGraph *inducedGraph(const ConflictGraph *g, const std::vector<int> &vertices, const std::vector<int> &local);
+
+
+
+/***************************
+ ** COMPONENTSOLVER CLASS **
+ ***************************/
+class ComponentSolver {
+public:
+  enum Class {
+    TINY = 0,
+    MEDIUM,
+    LARGE
+  };
+
+private:
+  const ConflictGraph *g;                 // Conflict graph
+  ThreadPool *pool;                       // Where components are solved
+  int tinyLimit, mediumLimit;             // Classification thresholds (vertices)
+  double mediumDensity;                   // Classification threshold (density)
+
+  int count;                              // Number of components
+  std::vector<int> first, members;        // Vertices of component c are members[first[c]..first[c+1]-1]
+  std::vector<int> local;                 // Position of each vertex in its component
+  std::vector<Class> classes;             // Class of each component
+  std::vector<std::vector<int>> solution; // Solution of each component (vertices of g)
+  std::vector<char> exact;                // Whether each solution is optimal
+
+  std::mutex lock;                        // Guards running
+  std::condition_variable finished;       // Signaled when a component ends
+  int running;                            // Tasks not finished
+  std::atomic<bool> cancel;               // Set on deadline
+  std::atomic<long> left;                 // Vertices in medium and large components not started
+  std::chrono::steady_clock::time_point start; // When run() started
+  double deadline;                        // Seconds allowed
+
+  // Solvers for component c
+  void solveTiny(int c);
+  void solveMedium(int c);
+  void solveLarge(int c);
+
+  // Seconds since run() started
+  double elapsed(void) const;
+
+public:
+  // Splits g into components and classifies them
+  ComponentSolver(const ConflictGraph *g, ThreadPool *pool, int tinyLimit = 20, int mediumLimit = 256, double mediumDensity = 0.1);
+
+  // Solves every component in about seconds at most, returns the merged solution
+  std::vector<int> run(double seconds);
+
+  // Returns the number of components
+  inline int getComponents(void) const { return count; }
+
+  // Returns the number of vertices of component c
+  inline int getSize(int c) const { return first[c+1] - first[c]; }
+
+  // Returns the class of component c
+  inline Class getClass(int c) const { return classes[c]; }
+
+  // Returns the number of components of a class
+  int countClass(Class k) const;
+
+  // Returns true if every component was solved to optimality in the last run()
+  bool optimal(void) const;
+
+  // Prints component counts per class and how many were solved exactly
+  void print(void) const;
+};
+
+
+#endif /* components.hpp  */
@@ -0,0 +1,112 @@
+/**
+   Copyright (C) 2016 Diego Rubert
+
+   This file is part of the O(k)-approximation algorithm implementation
+   for the DCJ distance on linear unichromosomal genomes in:
+
+   Diego P. Rubert, Pedro Feijão, Marília D. V. Braga, Jens Stoye and Fábio V. Martinez
+   A Linear Time Approximation Algorithm for the DCJ Distance for Genomes with Bounded Number of Duplicates
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <vector>
+#include <algorithm>
+
+#include "graph.hpp"
+#include "paths-cycles.hpp"
+#include "conflict-graph.hpp"
+
+
+using std::vector;
+
+
+
+/***************************
+ ** CONFLICTGRAPH METHODS **
+ ***************************/
+ConflictGraph::ConflictGraph(CyclesGraph *cg, const vector<double> *weights) :
+  n(cg->getN())
+{
+  vector<int> index(cg->getMaxVertexId() + 1, -1); // CyclesGraph id -> frozen id
+  int i = 0;
+
+  ids.resize(n);
+  cycles.resize(n);
+  w.resize(n, 1.0);
+  for (auto v : *cg) {
+    index[v->getId()] = i;
+    ids[i] = v->getId();
+    cycles[i] = (Path *) v->getData();
+    if (weights)
+      w[i] = (*weights)[v->getId()];
+    i++;
+  }
+
+  off.resize(n + 1, 0);
+  for (i = 0; i < n; i++)
+    off[i+1] = off[i] + cg->getVertex(ids[i])->getDegree();
+
+  adj.resize(off[n]);
+  for (i = 0; i < n; i++) {
+    int k = off[i];
+    for (auto e : *cg->getVertex(ids[i]))
+      adj[k++] = index[e->getAdj()->getId()];
+    std::sort(adj.begin() + off[i], adj.begin() + off[i+1]);
+  }
+}
+
+ConflictGraph::ConflictGraph(vector<int> &off, vector<int> &adj, vector<double> &weights) :
+  n((int) off.size() - 1)
+{
+  this->off.swap(off);
+  this->adj.swap(adj);
+  w.swap(weights);
+  ids.assign(n, -1);
+  cycles.assign(n, NULL);
+
+  for (int i = 0; i < n; i++)
+    std::sort(this->adj.begin() + this->off[i], this->adj.begin() + this->off[i+1]);
+}
+
+double ConflictGraph::weight(const vector<int> &set) const
+{
+  double total = 0;
+  for (auto v : set)
+    total += w[v];
+  return total;
+}
+
+bool ConflictGraph::adjacent(int u, int v) const
+{
+  if (degree(u) > degree(v)) { // search in the smaller list
+    int t = u; u = v; v = t;
+  }
+  return std::binary_search(begin(u), end(u), v);
+}
+
+bool ConflictGraph::independent(const vector<int> &set) const
+{
+  vector<char> in(n, 0);
+
+  for (auto v : set)
+    in[v] = 1;
+
+  for (auto v : set)
+    for (const int *u = begin(v); u != end(v); u++)
+      if (in[*u])
+        return false;
+
+  return true;
+}
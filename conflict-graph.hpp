@@ -0,0 +1,103 @@
+/**
+   Copyright (C) 2016 Diego Rubert
+
+   This file is part of the O(k)-approximation algorithm implementation
+   for the DCJ distance on linear unichromosomal genomes in:
+
+   Diego P. Rubert, Pedro Feijão, Marília D. V. Braga, Jens Stoye and Fábio V. Martinez
+   A Linear Time Approximation Algorithm for the DCJ Distance for Genomes with Bounded Number of Duplicates
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+  Frozen (read only) view of a CyclesGraph, stored in compressed
+  sparse rows. Vertices are renumbered 0..n-1 and each one keeps the
+  cycle it represents and a weight (1 by default). Algorithms that
+  only read the conflict graph many times (bounds, solvers) should
+  use this instead of walking the linked lists of the CyclesGraph.
+*/
+
+#ifndef _CONFLICT_GRAPH_HPP
+
+#define _CONFLICT_GRAPH_HPP 1
+
+#include <vector>
+
+#include "graph.hpp"
+#include "paths-cycles.hpp"
+
+
+
+/*************************
+ ** CONFLICTGRAPH CLASS **
+ *************************/
+class ConflictGraph {
+private:
+  int n;                      // Number of vertices
+  std::vector<int> off;       // Adjacency of v is adj[off[v]..off[v+1]-1], sorted
+  std::vector<int> adj;       // Concatenated adjacency lists
+  std::vector<double> w;      // Vertex weights
+  std::vector<int> ids;       // Id of each vertex in the CyclesGraph
+  std::vector<Path *> cycles; // Cycle represented by each vertex (owned by the CyclesGraph)
+
+public:
+  // Freezes a CyclesGraph. If weights is given, it must be indexed by
+  // CyclesGraph vertex ids, otherwise every cycle weights 1
+  ConflictGraph(CyclesGraph *cg, const std::vector<double> *weights = NULL);
+
+  // Builds a graph whose vertices are not cycles (e.g. a coarsened
+  // one) from adjacency arrays, which are taken (left empty). Lists
+  // are sorted here, cgId() is -1 and cycle() is NULL for every vertex
+  ConflictGraph(std::vector<int> &off, std::vector<int> &adj, std::vector<double> &weights);
+
+  // Returns the number of vertices
+  inline int getN(void) const { return n; }
+
+  // Returns the number of edges
+  inline long getM(void) const { return (long) adj.size() / 2; }
+
+  // Returns the degree of v
+  inline int degree(int v) const { return off[v+1] - off[v]; }
+
+  // Returns the first neighbor of v (neighbors are sorted)
+  inline const int *begin(int v) const { return adj.data() + off[v]; }
+
+  // Returns one past the last neighbor of v
+  inline const int *end(int v) const { return adj.data() + off[v+1]; }
+
+  // Returns the weight of v
+  inline double weight(int v) const { return w[v]; }
+
+  // Returns the id of v in the CyclesGraph
+  inline int cgId(int v) const { return ids[v]; }
+
+  // Returns the cycle (in the adjacency graph) represented by v, NULL if none
+  inline Path *cycle(int v) const { return cycles[v]; }
+
+  // Returns true if vertices represent cycles
+  inline bool hasCycles(void) const { return n == 0 || cycles[0] != NULL; }
+
+  // Returns the sum of weights of the vertices in set
+  double weight(const std::vector<int> &set) const;
+
+  // Returns true if u and v are adjacent (binary search, O(log deg))
+  bool adjacent(int u, int v) const;
+
+  // Returns true if no two vertices in set are adjacent
+  bool independent(const std::vector<int> &set) const;
+};
+
+
+#endif /* conflict-graph.hpp  */
@@ -0,0 +1,243 @@
+/**
+   Copyright (C) 2016 Diego Rubert
+
+   This file is part of the O(k)-approximation algorithm implementation
+   for the DCJ distance on linear unichromosomal genomes in:
+
+   Diego P. Rubert, Pedro Feijão, Marília D. V. Braga, Jens Stoye and Fábio V. Martinez
+   A Linear Time Approximation Algorithm for the DCJ Distance for Genomes with Bounded Number of Duplicates
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdio>
+#include <vector>
+#include <algorithm>
+
+#include "graph.hpp"
+#include "paths-cycles.hpp"
+#include "decomposition.hpp"
+
+
+using std::vector;
+
+
+
+/**********************
+ ** DCJSCORE METHODS **
+ **********************/
+void DCJScore::print(void) const
+{
+  printf("genes: %d, cycles: %d, odd paths: %d, even paths: %d, distance: %d, similarity: %g\n",
+         genes, cycles, oddPaths, evenPaths, distance, similarity);
+}
+
+
+
+/***************************
+ ** DECOMPOSITION METHODS **
+ ***************************/
+Decomposition::Decomposition(Graph *ag) :
+  part(ag->getN() > 0 ? ag->begin()->getPart() : 0), // same part CyclesGraph starts from
+  genes(0),
+  nv(ag->getMaxVertexId() + 1)
+{
+  int maxex = 0;
+
+  for (auto v : *ag)
+    maxex = std::max(maxex, std::max(v->getExtremityLeft().index(), v->getExtremityRight().index()) + 1);
+  maxex += maxex % 2; // so both extremities of the last gene fit
+
+  vertexOf.assign(maxex, -1);
+  exOf.assign(2 * nv, -1);
+  inA.assign(maxex / 2, 0);
+  mate.assign(maxex / 2, 0);
+  mateW.assign(maxex / 2, 0);
+  candOff.assign(maxex / 2 + 1, 0);
+  present.assign(nv, 0);
+  visited.assign(nv, 0);
+
+  for (auto v : *ag) {
+    int id = v->getId();
+    present[id] = 1;
+    exOf[2*id] = v->getExtremityLeft().index();
+    exOf[2*id+1] = v->getExtremityRight().index();
+    for (int i = 2*id; i <= 2*id+1; i++)
+      if (exOf[i] >= 0) {
+        vertexOf[exOf[i]] = id;
+        if (v->getPart() == part) {
+          inA[exOf[i] / 2] = 1;
+          genes++;
+        }
+      }
+  }
+  genes /= 2; // we counted extremities
+
+  // candidate partners of each gene in A, taken from edges at its tail
+  // (or at its head if the edge has no sibling): counting pass + fill
+  auto candidate = [](Edge *e) {
+    return e->getExtremityFrom().getType() != Extremity::UNDEF && e->getExtremityTo().getType() != Extremity::UNDEF
+      && (e->getExtremityFrom().getType() == Extremity::TAIL || e->getSibling() == NULL);
+  };
+
+  for (auto it = ag->begin(part); it != ag->end(); ++it)
+    for (auto e : **it)
+      if (candidate(e))
+        candOff[e->getExtremityFrom().getId() + 1]++;
+  for (unsigned g = 1; g < candOff.size(); g++)
+    candOff[g] += candOff[g-1];
+
+  vector<int> pos(candOff.begin(), candOff.end() - 1);
+  cand.resize(candOff.back());
+  candW.resize(candOff.back());
+  for (auto it = ag->begin(part); it != ag->end(); ++it)
+    for (auto e : **it)
+      if (candidate(e)) {
+        int k = pos[e->getExtremityFrom().getId()]++;
+        cand[k] = e->getExtremityTo().getId();
+        candW[k] = e->getWeight();
+      }
+
+  vector<std::pair<double, int>> sorted;
+  for (unsigned g = 0; g + 1 < candOff.size(); g++) { // heaviest first, k is small
+    if (candOff[g+1] - candOff[g] < 2)
+      continue;
+    sorted.clear();
+    for (int k = candOff[g]; k < candOff[g+1]; k++)
+      sorted.push_back(std::make_pair(-candW[k], cand[k]));
+    std::stable_sort(sorted.begin(), sorted.end());
+    for (int k = candOff[g]; k < candOff[g+1]; k++) {
+      candW[k] = -sorted[k - candOff[g]].first;
+      cand[k] = sorted[k - candOff[g]].second;
+    }
+  }
+}
+
+void Decomposition::clear(void)
+{
+  std::fill(mate.begin(), mate.end(), 0);
+  std::fill(mateW.begin(), mateW.end(), 0);
+}
+
+void Decomposition::match(int a, int b, double w)
+{
+  mate[a] = b;
+  mate[b] = a;
+  mateW[a] = mateW[b] = w;
+}
+
+void Decomposition::unmatch(int a)
+{
+  int b = mate[a];
+  mate[a] = 0;
+  if (b)
+    mate[b] = 0;
+}
+
+bool Decomposition::consistent(Path *c) const
+{
+  for (int i = 0; i < c->lenE(); i++) {
+    Extremity from = c->nthE(i)->getExtremityFrom(), to = c->nthE(i)->getExtremityTo();
+    if (from.getType() == Extremity::UNDEF || to.getType() == Extremity::UNDEF)
+      continue;
+    if ((mate[from.getId()] && mate[from.getId()] != to.getId()) || (mate[to.getId()] && mate[to.getId()] != from.getId()))
+      return false;
+  }
+  return true;
+}
+
+bool Decomposition::add(Path *c)
+{
+  if (!consistent(c))
+    return false;
+
+  for (int i = 0; i < c->lenE(); i++) {
+    Edge *e = c->nthE(i);
+    Extremity from = e->getExtremityFrom(), to = e->getExtremityTo();
+    if (from.getType() != Extremity::UNDEF && to.getType() != Extremity::UNDEF)
+      match(from.getId(), to.getId(), e->getWeight());
+  }
+  return true;
+}
+
+void Decomposition::complete(void)
+{
+  for (unsigned a = 0; a < inA.size(); a++) {
+    if (!inA[a] || mate[a])
+      continue;
+    for (int k = candOff[a]; k < candOff[a+1]; k++)
+      if (mate[cand[k]] == 0) {
+        match(a, cand[k], candW[k]);
+        break;
+      }
+  }
+}
+
+int Decomposition::walk(int v, int x, double &w)
+{
+  int len = 0, u = v;
+
+  visited[v] = 1;
+  while (x >= 0 && mate[x / 2]) {
+    int y = 2 * mate[x / 2] + (x & 1); // same type extremity of the mate
+    len++;
+    w += mateW[x / 2];
+    u = vertexOf[y];
+    if (u == v) // closed a cycle
+      break;
+    visited[u] = 1;
+    x = exOf[2*u] == y ? exOf[2*u+1] : exOf[2*u]; // leave u by its other extremity
+  }
+
+  return len;
+}
+
+DCJScore Decomposition::score(void)
+{
+  DCJScore s = {genes, 0, 0, 0, 0, 0.0};
+
+  for (int v = 0; v < nv; v++) // vertices not in ag are never walked
+    visited[v] = !present[v];
+
+  // paths start at vertices with some free (or null) extremity
+  for (int v = 0; v < nv; v++) {
+    if (visited[v])
+      continue;
+    int x0 = exOf[2*v], x1 = exOf[2*v+1];
+    bool m0 = x0 >= 0 && mate[x0 / 2], m1 = x1 >= 0 && mate[x1 / 2];
+    if (m0 && m1)
+      continue;
+
+    double w = 0;
+    int len = walk(v, m0 ? x0 : (m1 ? x1 : -1), w);
+    if (len % 2) {
+      s.oddPaths++;
+      s.similarity += w / len / 2;
+    }
+    else
+      s.evenPaths++;
+  }
+
+  // everything else is in cycles
+  for (int v = 0; v < nv; v++)
+    if (!visited[v]) {
+      double w = 0;
+      int len = walk(v, exOf[2*v], w);
+      s.cycles++;
+      s.similarity += w / len;
+    }
+
+  s.distance = genes - s.cycles - s.oddPaths / 2;
+  return s;
+}
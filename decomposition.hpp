@@ -0,0 +1,142 @@
+/**
+   Copyright (C) 2016 Diego Rubert
+
+   This file is part of the O(k)-approximation algorithm implementation
+   for the DCJ distance on linear unichromosomal genomes in:
+
+   Diego P. Rubert, Pedro Feijão, Marília D. V. Braga, Jens Stoye and Fábio V. Martinez
+   A Linear Time Approximation Algorithm for the DCJ Distance for Genomes with Bounded Number of Duplicates
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+  Decomposition of an adjacency graph induced by a gene matching, and
+  its DCJ scores. The adjacency graph is indexed once into flat arrays
+  (gene extremity -> vertex, vertex -> extremities, candidate partners
+  of each gene), so fixing packed cycles, completing the matching and
+  walking the resulting cycles and paths are all O(n) and never touch
+  (nor build) Graph objects. The adjacency graph may even be modified
+  or destroyed after the index is built.
+
+  Scores of a decomposition with c cycles and i odd paths of a pair of
+  genomes with n genes each:
+  * distance: n - (c + i/2)
+  * similarity: sum of w(C)/|C| over cycles plus half of the same
+    over odd paths, where w() is the sum of edge weights (gene
+    similarities) and |.| the number of edges. With unit weights it
+    is c + i/2, i.e. n - distance
+*/
+
+#ifndef _DECOMPOSITION_HPP
+
+#define _DECOMPOSITION_HPP 1
+
+#include <vector>
+
+#include "graph.hpp"
+#include "paths-cycles.hpp"
+
+
+
+/********************
+ ** DCJSCORE CLASS **
+ ********************/
+// Scores and component counts of a decomposition
+struct DCJScore {
+  int genes;         // Number of genes (in genome A)
+  int cycles;        // Number of cycles
+  int oddPaths;      // Number of odd paths
+  int evenPaths;     // Number of even paths (including isolated vertices)
+  int distance;      // DCJ distance, genes - (cycles + oddPaths/2)
+  double similarity; // DCJ similarity (see above)
+
+  // Prints the scores
+  void print(void) const;
+};
+
+
+/*************************
+ ** DECOMPOSITION CLASS **
+ *************************/
+class Decomposition {
+private:
+  char part;                     // Part of the adjacency graph holding genome A
+  int genes;                     // Number of genes in genome A
+  int nv;                        // Greatest adjacency graph vertex id + 1
+  std::vector<int> vertexOf;     // Vertex of each gene extremity (Extremity::index), -1 if none
+  std::vector<int> exOf;         // Extremity indices of each vertex v at 2v and 2v+1, -1 if null
+  std::vector<char> inA;         // Whether each gene is in genome A
+  std::vector<int> candOff;      // Candidates of gene g are cand[candOff[g]..candOff[g+1]-1]
+  std::vector<int> cand;         // Candidate partner genes, heaviest first
+  std::vector<double> candW;     // Weight of each candidate pair
+  std::vector<int> mate;         // Gene matched to each gene (0 = free)
+  std::vector<double> mateW;     // Weight of the pair each gene is matched in
+  std::vector<char> present;     // Whether each vertex id is in the adjacency graph
+  std::vector<char> visited;     // Scratch for walks
+
+  // Walks the component from vertex v leaving by extremity index x (or
+  // any matched extremity if x < 0) until a path end or back to v.
+  // Returns the number of edges, adds the weights to w
+  int walk(int v, int x, double &w);
+
+public:
+  // Indexes an adjacency graph, O(n + m)
+  Decomposition(Graph *ag);
+
+  // Returns the part of the adjacency graph holding genome A
+  inline char getPart(void) const { return part; }
+
+  // Returns the number of genes in genome A
+  inline int getGenes(void) const { return genes; }
+
+  // Returns the greatest gene id + 1
+  inline int getMaxGeneId(void) const { return (int) mate.size(); }
+
+  // Returns the adjacency graph vertex id of an extremity, -1 if none
+  inline int getVertex(Extremity ex) const {
+    return ex.index() >= 0 && ex.index() < (int) vertexOf.size() ? vertexOf[ex.index()] : -1;
+  }
+
+  // Returns the gene matched to gene id (0 = free)
+  inline int getMate(int id) const { return mate[id]; }
+
+  // Returns the number of candidate partners of gene id
+  inline int candidates(int id) const { return candOff[id+1] - candOff[id]; }
+
+  // Unmatches all genes
+  void clear(void);
+
+  // Matches genes a and b with weight w (both must be free)
+  void match(int a, int b, double w = 1.0);
+
+  // Unmatches gene a and its mate
+  void unmatch(int a);
+
+  // Returns true if every gene pair in cycle c is free or already matched the same way
+  bool consistent(Path *c) const;
+
+  // Fixes the gene matchings of a cycle, returns false (changing
+  // nothing) if it is inconsistent with the current matching
+  bool add(Path *c);
+
+  // Matches every free gene to its heaviest free candidate, O(n k)
+  void complete(void);
+
+  // Walks the decomposition and computes its scores, O(n)
+  DCJScore score(void);
+};
+
+
+#endif /* decomposition.hpp  */
@@ -0,0 +1,288 @@
+/**
+   Copyright (C) 2016 Diego Rubert
+
+   This file is part of the O(k)-approximation algorithm implementation
+   for the DCJ distance on linear unichromosomal genomes in:
+
+   Diego P. Rubert, Pedro Feijão, Marília D. V. Braga, Jens Stoye and Fábio V. Martinez
+   A Linear Time Approximation Algorithm for the DCJ Distance for Genomes with Bounded Number of Duplicates
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <vector>
+#include <algorithm>
+
+#include "graph.hpp"
+#include "paths-cycles.hpp"
+#include "conflict-graph.hpp"
+#include "decomposition.hpp"
+#include "delta-scoring.hpp"
+
+
+using std::vector;
+
+
+
+/*************************
+ ** DELTASCORER METHODS **
+ *************************/
+DeltaScorer::DeltaScorer(Graph *ag, const ConflictGraph *g) :
+  dec(ag ? new Decomposition(ag) : NULL),
+  g(g),
+  in(g->getN(), 0),
+  value(g->getN(), 0),
+  packed(0),
+  similarity(0),
+  rstamp(g->getN(), 0),
+  stamp(0)
+{
+  if (!dec) { // conflicts and values from g only
+    vstamp.assign(g->getN(), 0);
+    for (int c = 0; c < g->getN(); c++)
+      value[c] = g->weight(c);
+    return;
+  }
+
+  owner.assign(2 * dec->getMaxGeneId(), -1);
+  vowner.assign(ag->getMaxVertexId() + 1, -1);
+  tmate.assign(dec->getMaxGeneId(), 0);
+  tstamp.assign(dec->getMaxGeneId(), 0);
+  vstamp.assign(ag->getMaxVertexId() + 1, 0);
+
+  for (int c = 0; c < g->getN(); c++) {
+    Path *p = g->cycle(c);
+    double w = 0;
+    for (int i = 0; i < p->lenE(); i++)
+      w += p->nthE(i)->getWeight();
+    value[c] = p->lenE() > 0 ? w / p->lenE() : 0;
+  }
+}
+
+DeltaScorer::~DeltaScorer()
+{
+  delete dec; // no problem if NULL
+}
+
+void DeltaScorer::blockers(int c, vector<int> &out)
+{
+  unsigned first = out.size();
+
+  if (!dec) {
+    for (const int *u = g->begin(c); u != g->end(c); u++)
+      if (in[*u])
+        out.push_back(*u);
+    return;
+  }
+
+  Path *p = g->cycle(c);
+  auto block = [&](int x) {
+    if (x >= 0 && x != c && std::find(out.begin() + first, out.end(), x) == out.end())
+      out.push_back(x);
+  };
+
+  for (auto v : *p) // cycles in a decomposition are vertex disjoint
+    block(vowner[v->getId()]);
+
+  for (int i = 0; i < p->lenE(); i++) {
+    Extremity from = p->nthE(i)->getExtremityFrom(), to = p->nthE(i)->getExtremityTo();
+    if (from.getType() == Extremity::UNDEF || to.getType() == Extremity::UNDEF)
+      continue;
+    int a = from.getId(), b = to.getId();
+    if (dec->getMate(a) && dec->getMate(a) != b) { // a matched elsewhere (by one or two cycles)
+      block(owner[2*a]);
+      block(owner[2*a+1]);
+    }
+    if (dec->getMate(b) && dec->getMate(b) != a) {
+      block(owner[2*b]);
+      block(owner[2*b+1]);
+    }
+  }
+}
+
+DCJDelta DeltaScorer::insertDelta(int c)
+{
+  DCJDelta d = {true, 0, 0};
+  vector<int> out;
+
+  if (in[c])
+    return d;
+
+  blockers(c, out);
+  d.cycles = 1 - out.size();
+  d.similarity = value[c];
+  for (auto x : out)
+    d.similarity -= value[x];
+  return d;
+}
+
+DCJDelta DeltaScorer::removeDelta(int c)
+{
+  DCJDelta d = {true, 0, 0};
+
+  if (in[c]) {
+    d.cycles = -1;
+    d.similarity = -value[c];
+  }
+  return d;
+}
+
+DCJDelta DeltaScorer::swapDelta(const vector<int> &out, const vector<int> &into)
+{
+  DCJDelta d = {true, 0, 0};
+  vector<int> blocking;
+
+  stamp++;
+  for (auto x : out)
+    if (in[x]) {
+      rstamp[x] = stamp;
+      d.cycles--;
+      d.similarity -= value[x];
+    }
+
+  for (auto c : into) {
+    if (in[c] && rstamp[c] != stamp) { // already packed and kept
+      d.feasible = false;
+      return d;
+    }
+
+    blocking.clear();
+    blockers(c, blocking);
+    for (auto x : blocking)
+      if (rstamp[x] != stamp) { // blocked by a cycle we keep
+        d.feasible = false;
+        return d;
+      }
+
+    if (!dec) { // not repeated nor adjacent to other inserted cycles
+      if (vstamp[c] == stamp) {
+        d.feasible = false;
+        return d;
+      }
+      vstamp[c] = stamp;
+      for (const int *u = g->begin(c); u != g->end(c); u++)
+        if (vstamp[*u] == stamp) {
+          d.feasible = false;
+          return d;
+        }
+      d.cycles++;
+      d.similarity += value[c];
+      continue;
+    }
+
+    Path *p = g->cycle(c);
+    for (auto v : *p) { // disjoint from other inserted cycles
+      if (vstamp[v->getId()] == stamp) {
+        d.feasible = false;
+        return d;
+      }
+      vstamp[v->getId()] = stamp;
+    }
+    for (int i = 0; i < p->lenE(); i++) { // and consistent with them
+      Extremity from = p->nthE(i)->getExtremityFrom(), to = p->nthE(i)->getExtremityTo();
+      if (from.getType() == Extremity::UNDEF || to.getType() == Extremity::UNDEF)
+        continue;
+      int a = from.getId(), b = to.getId();
+      if ((tstamp[a] == stamp && tmate[a] != b) || (tstamp[b] == stamp && tmate[b] != a)) {
+        d.feasible = false;
+        return d;
+      }
+      tstamp[a] = tstamp[b] = stamp;
+      tmate[a] = b;
+      tmate[b] = a;
+    }
+
+    d.cycles++;
+    d.similarity += value[c];
+  }
+
+  return d;
+}
+
+void DeltaScorer::insert(int c, vector<int> *evicted)
+{
+  vector<int> out;
+
+  if (in[c])
+    return;
+
+  blockers(c, out);
+  for (auto x : out)
+    remove(x);
+  if (evicted)
+    evicted->insert(evicted->end(), out.begin(), out.end());
+
+  in[c] = 1;
+  packed++;
+  similarity += value[c];
+  if (!dec)
+    return;
+
+  Path *p = g->cycle(c);
+  for (auto v : *p)
+    vowner[v->getId()] = c;
+  for (int i = 0; i < p->lenE(); i++) {
+    Extremity from = p->nthE(i)->getExtremityFrom(), to = p->nthE(i)->getExtremityTo();
+    if (from.getType() == Extremity::UNDEF || to.getType() == Extremity::UNDEF)
+      continue;
+    owner[from.index()] = owner[to.index()] = c;
+  }
+  dec->add(p);
+}
+
+void DeltaScorer::remove(int c)
+{
+  if (!in[c])
+    return;
+
+  in[c] = 0;
+  packed--;
+  similarity -= value[c];
+  if (!dec)
+    return;
+
+  Path *p = g->cycle(c);
+  for (auto v : *p)
+    vowner[v->getId()] = -1;
+  for (int i = 0; i < p->lenE(); i++) {
+    Extremity from = p->nthE(i)->getExtremityFrom(), to = p->nthE(i)->getExtremityTo();
+    if (from.getType() == Extremity::UNDEF || to.getType() == Extremity::UNDEF)
+      continue;
+    owner[from.index()] = owner[to.index()] = -1;
+    if (owner[(!from).index()] < 0) // sibling extremity not used by another packed cycle
+      dec->unmatch(from.getId());
+  }
+}
+
+vector<int> DeltaScorer::solution(void) const
+{
+  vector<int> chosen;
+
+  for (int c = 0; c < g->getN(); c++)
+    if (in[c])
+      chosen.push_back(c);
+  return chosen;
+}
+
+DCJScore DeltaScorer::finalScore(void) const
+{
+  if (!dec) {
+    DCJScore none = {0, 0, 0, 0, 0, 0.0};
+    return none;
+  }
+
+  Decomposition copy = *dec;
+  copy.complete();
+  return copy.score();
+}
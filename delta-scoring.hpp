@@ -0,0 +1,145 @@
+/**
+   Copyright (C) 2016 Diego Rubert
+
+   This file is part of the O(k)-approximation algorithm implementation
+   for the DCJ distance on linear unichromosomal genomes in:
+
+   Diego P. Rubert, Pedro Feijão, Marília D. V. Braga, Jens Stoye and Fábio V. Martinez
+   A Linear Time Approximation Algorithm for the DCJ Distance for Genomes with Bounded Number of Duplicates
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+  Incremental scoring of packing moves. A DeltaScorer keeps the
+  partial decomposition induced by the packed cycles (vertices of the
+  ConflictGraph) and answers how inserting, removing or swapping
+  cycles changes its score, in time proportional to the length of the
+  cycles involved:
+
+  * every packed cycle is a component of the final decomposition, so
+    it adds exactly one cycle and w(C)/|C| to the similarity
+  * the completion of the remaining genes can only add components,
+    so genes - packed is an upper bound on the final distance, and
+    its delta is minus the delta in packed cycles
+
+  The exact final score is given by finalScore(), which completes and
+  walks a copy of the decomposition.
+
+  Without an adjacency graph (e.g. for coarsened conflict graphs, whose
+  vertices are not cycles) conflicts are taken from the ConflictGraph
+  edges instead, moves cost O(degree) and values are vertex weights.
+*/
+
+#ifndef _DELTA_SCORING_HPP
+
+#define _DELTA_SCORING_HPP 1
+
+#include <vector>
+
+#include "graph.hpp"
+#include "paths-cycles.hpp"
+#include "conflict-graph.hpp"
+#include "decomposition.hpp"
+
+
+
+/********************
+ ** DCJDELTA CLASS **
+ ********************/
+// Change in the score of the partial decomposition caused by a move
+struct DCJDelta {
+  bool feasible;     // False if the move would leave inconsistent cycles packed
+  int cycles;        // Change in packed cycles (the distance bound changes by -cycles)
+  double similarity; // Change in similarity
+};
+
+
+/***********************
+ ** DELTASCORER CLASS **
+ ***********************/
+class DeltaScorer {
+private:
+  Decomposition *dec;         // Genes matched by packed cycles only (NULL without adjacency graph)
+  const ConflictGraph *g;     // Cycles that may be packed
+  std::vector<int> owner;     // Packed cycle using each gene extremity (Extremity::index), -1 if none
+  std::vector<int> vowner;    // Packed cycle through each adjacency graph vertex, -1 if none
+  std::vector<char> in;       // Whether each cycle is packed
+  std::vector<double> value;  // Similarity contribution of each cycle, w(C)/|C|
+  int packed;                 // Number of packed cycles
+  double similarity;          // Similarity of packed cycles
+  std::vector<int> tmate;     // Scratch: tentative mates in swapDelta
+  std::vector<int> tstamp;    // Scratch: swapDelta call that set tmate
+  std::vector<int> rstamp;    // Scratch: swapDelta call that removes each cycle
+  std::vector<int> vstamp;    // Scratch: swapDelta call that used each vertex (or inserts each cycle)
+  int stamp;                  // Current swapDelta call
+
+public:
+  // Starts with no packed cycles. The adjacency graph must be the one
+  // the CyclesGraph frozen in g was built from (it is only indexed
+  // here), if NULL conflicts come from the edges of g
+  DeltaScorer(Graph *ag, const ConflictGraph *g);
+
+  // Destructor
+  ~DeltaScorer();
+
+  // Not copyable (owns the decomposition)
+  DeltaScorer(const DeltaScorer &) = delete;
+  DeltaScorer &operator=(const DeltaScorer &) = delete;
+
+  // Returns the number of packed cycles
+  inline int getPacked(void) const { return packed; }
+
+  // Returns the similarity of the packed cycles
+  inline double getSimilarity(void) const { return similarity; }
+
+  // Returns the upper bound on the final distance, genes - packed (-1 without adjacency graph)
+  inline int distanceBound(void) const { return dec ? dec->getGenes() - packed : -1; }
+
+  // Returns true if cycle c is packed
+  inline bool isPacked(int c) const { return in[c]; }
+
+  // Returns the similarity contribution of cycle c
+  inline double getValue(int c) const { return value[c]; }
+
+  // Appends to out the packed cycles inconsistent with c (without repetitions)
+  void blockers(int c, std::vector<int> &out);
+
+  // Delta of inserting c, evicting its blockers
+  DCJDelta insertDelta(int c);
+
+  // Delta of removing packed cycle c
+  DCJDelta removeDelta(int c);
+
+  // Delta of removing packed cycles out and inserting cycles into. It
+  // is feasible if cycles in into are pairwise consistent and every
+  // blocker of them is in out
+  DCJDelta swapDelta(const std::vector<int> &out, const std::vector<int> &into);
+
+  // Inserts c, evicting its blockers (appended to evicted, if given)
+  void insert(int c, std::vector<int> *evicted = NULL);
+
+  // Removes packed cycle c
+  void remove(int c);
+
+  // Returns the packed cycles
+  std::vector<int> solution(void) const;
+
+  // Completes a copy of the partial decomposition and scores it, O(n)
+  // (all zeros without adjacency graph)
+  DCJScore finalScore(void) const;
+};
+
+
+#endif /* delta-scoring.hpp  */
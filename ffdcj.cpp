@@ -0,0 +1,450 @@
+/**
+   Copyright (C) 2016 Diego Rubert
+
+   This file is part of the O(k)-approximation algorithm implementation
+   for the DCJ distance on linear unichromosomal genomes in:
+
+   Diego P. Rubert, Pedro Feijão, Marília D. V. Braga, Jens Stoye and Fábio V. Martinez
+   A Linear Time Approximation Algorithm for the DCJ Distance for Genomes with Bounded Number of Duplicates
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+  Command line driver: runs a stream of comparison jobs with a pool of
+  worker threads and streams one result record per job as it finishes.
+
+    ffdcj [-t threads] [-c cache] [-g dir] [-m] [-o output] [jobs]
+
+  Jobs are read from a file (or stdin if none, or '-'), one per line,
+  so a workflow manager can keep a single process fed through a pipe:
+
+    genomes-file [genome-A genome-B] [key=value ...]
+
+  comparing the named genomes of a UniMoG/GRIMM file (the first two of
+  the file if not named). Keys: id (default: the line number), hits (a
+  BLAST tabular file: genes are joined by similarity hits instead of
+  by family), maxlen (length of cycles in the last round, 0 = 2k),
+  copies (high-copy fallback threshold, 0 = none), collapse (0/1,
+  collapse synteny blocks first, ignored with hits). Blank lines and
+  lines starting with '#' are skipped.
+
+  Records are tab separated lines (see the header line written first):
+  id, status ("ok" or an error), the DCJ scores, whether the result
+  came from the cache (-c, see result-cache.hpp) and the seconds taken
+  by each stage (load: parsing inputs, graph: collapsing and building
+  the adjacency graph, pack: packing and scoring) and by the whole job.
+  Jobs are read ahead only a few per thread, so a long stream never
+  piles up in memory. With -m all jobs share a PackingMemo. With -g the
+  parsed genome pair and hits of a job are kept in a directory (see
+  genome-cache.hpp), keyed by the content of the files, the genome
+  names and the hit filters, so later jobs on unchanged inputs load a
+  memory mapped binary file instead of parsing.
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <unistd.h>
+
+#include "graph.hpp"
+#include "genome.hpp"
+#include "genome-parser.hpp"
+#include "name-index.hpp"
+#include "blast.hpp"
+#include "adjacency-graph.hpp"
+#include "synteny.hpp"
+#include "decomposition.hpp"
+#include "packing-memo.hpp"
+#include "packing.hpp"
+#include "genome-cache.hpp"
+#include "result-cache.hpp"
+#include "thread-pool.hpp"
+
+
+using std::vector;
+using std::string;
+
+
+
+/*******************
+ ** AUX FUNCTIONS **
+ *******************/
+typedef std::chrono::steady_clock Clock;
+
+// Specification of a job
+struct Job {
+  string id;        // Id echoed in the record
+  string genomes;   // Genome file
+  string nameA;     // Genome A ("" = first of the file)
+  string nameB;     // Genome B ("" = second of the file)
+  string hits;      // Similarity hits ("" = join genes by family)
+  int maxLen;       // Length of cycles in the last round (0 = 2k)
+  int copies;       // High-copy fallback threshold (0 = none)
+  bool collapse;    // Collapse synteny blocks first
+  string error;     // Why the specification is invalid ("" = valid)
+};
+
+// Outcome of a job
+struct JobResult {
+  string error;     // Why the job failed ("" = it didn't)
+  DCJScore score;   // Scores of the comparison
+  bool cached;      // Scores came from the result cache
+  double load;      // Seconds parsing inputs
+  double graph;     // Seconds collapsing and building the adjacency graph
+  double pack;      // Seconds packing and scoring
+  double total;     // Seconds of the whole job
+};
+
+// State shared by the jobs
+struct Driver {
+  ThreadPool *pool;          // Runs the jobs
+  PackingMemo *memo;         // Shared memo (NULL = none)
+  ResultCache *cache;        // Result cache (NULL = none)
+  const char *genomeCache;   // Directory of the genome cache (NULL = none)
+  FILE *out;                 // Where records go
+  std::mutex lock;           // Guards out and the counters
+  std::condition_variable finished; // Signaled when a job finishes
+  int running;               // Jobs submitted and not finished
+  long jobs;                 // Jobs finished
+  long failed;               // Jobs that failed
+};
+
+// Returns the seconds since t and moves t to now
+static double lap(Clock::time_point &t)
+{
+  Clock::time_point now = Clock::now();
+  double s = std::chrono::duration<double>(now - t).count();
+
+  t = now;
+  return s;
+}
+
+// Parses a non-negative integer option, returns false if malformed
+static bool parseCount(const char *s, int &x)
+{
+  char *end;
+  long v = strtol(s, &end, 10);
+
+  if (end == s || *end || v < 0 || v > 1000000)
+    return false;
+  x = (int) v;
+  return true;
+}
+
+// Parses a line of the job list (modified in place), returns false if
+// there is no job on it (blank or comment)
+static bool parseJob(char *line, long number, Job &job)
+{
+  static const char *blanks = " \t\r\n";
+  int positional = 0;
+
+  job = Job{std::to_string(number), "", "", "", "", 0, 0, true, ""};
+  for (char *save, *tok = strtok_r(line, blanks, &save); tok; tok = strtok_r(NULL, blanks, &save)) {
+    if (positional == 0 && *tok == '#')
+      return false;
+
+    char *eq = strchr(tok, '=');
+    if (eq == NULL) {
+      string &s = positional == 0 ? job.genomes : (positional == 1 ? job.nameA : job.nameB);
+      if (positional++ > 2)
+        job.error = "too many fields";
+      else
+        s = tok;
+      continue;
+    }
+
+    *eq++ = '\0';
+    int x;
+    if (!strcmp(tok, "id"))
+      job.id = eq;
+    else if (!strcmp(tok, "hits"))
+      job.hits = eq;
+    else if (!strcmp(tok, "maxlen") && parseCount(eq, x))
+      job.maxLen = x;
+    else if (!strcmp(tok, "copies") && parseCount(eq, x))
+      job.copies = x;
+    else if (!strcmp(tok, "collapse") && parseCount(eq, x) && x <= 1)
+      job.collapse = x;
+    else
+      job.error = string("bad option ") + tok;
+  }
+
+  if (positional == 0)
+    return false;
+  if (positional == 2)
+    job.error = "genome B not named";
+  return true;
+}
+
+// Returns the genome named name (or the index-th if no name), NULL if
+// there is none
+static const Genome *findGenome(const vector<Genome> &genomes, const string &name, int index)
+{
+  if (name.empty())
+    return index < (int) genomes.size() ? &genomes[index] : NULL;
+  for (auto &g : genomes)
+    if (name == g.getName())
+      return &g;
+  return NULL;
+}
+
+// Parses the genomes and hits of a job, or loads them from the genome
+// cache (keyed by the content of the files, the genome names and the
+// hit filters), saving them there after parsing. Returns false (with
+// the reason in error) on error
+static bool loadInputs(const Job &job, Driver &d, Genome &a, Genome &b, NameIndex &names,
+                       vector<SimilarityEdge> &edges, uint64_t &similarity, string &error)
+{
+  BlastOptions options;
+  uint64_t key = 0;
+  string path;
+
+  if (!job.hits.empty() && !hashFile(job.hits.c_str(), similarity)) {
+    error = "cannot read " + job.hits;
+    return false;
+  }
+
+  if (d.genomeCache) {
+    if (!hashFile(job.genomes.c_str(), key)) {
+      error = "cannot read " + job.genomes;
+      return false;
+    }
+    double filters[3] = {options.minScore, options.maxEvalue, options.minIdentity};
+    char flags[2] = {options.identity, options.self}, hex[24];
+    key = contentHash(&similarity, sizeof(similarity), key);
+    key = contentHash(job.nameA.c_str(), job.nameA.size() + 1, key);
+    key = contentHash(job.nameB.c_str(), job.nameB.size() + 1, key);
+    key = contentHash(filters, sizeof(filters), key);
+    key = contentHash(flags, sizeof(flags), key);
+    snprintf(hex, sizeof(hex), "%016llx", (unsigned long long) key);
+    path = string(d.genomeCache) + "/" + hex + ".pair";
+    if (loadGenomePair(path.c_str(), key, a, b, names, edges))
+      return true;
+  }
+
+  NameIndex families;
+  vector<Genome> genomes;
+  GenomeParser parser(&families);
+  if (!parser.parseFile(job.genomes.c_str(), genomes, d.pool)) {
+    error = "cannot read " + job.genomes;
+    return false;
+  }
+  const Genome *pa = findGenome(genomes, job.nameA, 0), *pb = findGenome(genomes, job.nameB, 1);
+  if (pa == NULL || pb == NULL) {
+    error = "no genome " + (pa == NULL ? (job.nameA.empty() ? string("A") : job.nameA) :
+                                         (job.nameB.empty() ? string("B") : job.nameB));
+    return false;
+  }
+  BlastParser blast(&names, options);
+  if (!job.hits.empty() && !blast.parseFile(job.hits.c_str(), edges, d.pool)) {
+    error = "cannot read " + job.hits;
+    return false;
+  }
+  a = *pa;
+  b = *pb;
+
+  if (d.genomeCache) // a failure only costs parsing again next time
+    saveGenomePair(path.c_str(), key, a, b, names, edges);
+  return true;
+}
+
+// Runs a job
+static void runJob(const Job &job, Driver &d, JobResult &r)
+{
+  Clock::time_point start = Clock::now(), t = start;
+
+  r = JobResult{job.error, DCJScore(), false, 0, 0, 0, 0};
+  if (!r.error.empty())
+    return;
+
+  // load
+  NameIndex names;
+  Genome a, b;
+  vector<SimilarityEdge> edges;
+  uint64_t similarity = 0;
+  if (!loadInputs(job, d, a, b, names, edges, similarity, r.error))
+    return;
+  bool collapse = job.collapse && job.hits.empty();
+  r.load = lap(t);
+
+  // a cached result needs no graph at all
+  ResultKey key;
+  CachedResult cached;
+  if (d.cache) {
+    key = resultKey(genomeHash(a), genomeHash(b), similarity,
+                    ResultParams::packing(job.maxLen, job.copies, collapse, d.memo != NULL));
+    if (d.cache->find(key, cached)) {
+      r.score = cached.score;
+      r.cached = true;
+      r.total = lap(start);
+      return;
+    }
+  }
+
+  // graph
+  SyntenyBlocks blocks;
+  Genome ca, cb;
+  Graph *ag;
+  if (collapse) {
+    blocks.collapse(a, b, ca, cb);
+    ag = buildAdjacencyGraph(ca, cb, d.pool);
+  }
+  else if (job.hits.empty())
+    ag = buildAdjacencyGraph(a, b, d.pool);
+  else
+    ag = buildAdjacencyGraph(a, b, names, edges, d.pool);
+  r.graph = lap(t);
+
+  // pack
+  PackingEngine engine(ag, job.maxLen, d.memo, job.copies);
+  engine.run();
+  delete ag;
+  r.score = collapse ? blocks.expand(engine.getScore()) : engine.getScore();
+  r.pack = lap(t);
+  r.total = lap(start);
+
+  if (d.cache) {
+    cached = CachedResult::summarize(engine, r.total);
+    cached.score = r.score;
+    d.cache->store(key, cached);
+  }
+}
+
+// Writes the record of a job
+static void writeRecord(FILE *out, const Job &job, const JobResult &r)
+{
+  const DCJScore &s = r.score;
+
+  if (!r.error.empty()) {
+    fprintf(out, "%s\terror: %s\n", job.id.c_str(), r.error.c_str());
+    return;
+  }
+  fprintf(out, "%s\tok\t%d\t%d\t%d\t%d\t%d\t%g\t%d\t%.4f\t%.4f\t%.4f\t%.4f\n", job.id.c_str(),
+          s.genes, s.cycles, s.oddPaths, s.evenPaths, s.distance, s.similarity, (int) r.cached,
+          r.load, r.graph, r.pack, r.total);
+}
+
+// Prints the usage
+static void usage(const char *name)
+{
+  fprintf(stderr, "usage: %s [-t threads] [-c cache] [-g dir] [-m] [-o output] [jobs]\n", name);
+}
+
+
+
+/**********
+ ** MAIN **
+ **********/
+int main(int argc, char **argv)
+{
+  const char *cachePath = NULL, *outPath = NULL, *genomeDir = NULL;
+  int threads = 0, opt;
+  bool useMemo = false;
+
+  while ((opt = getopt(argc, argv, "t:c:g:mo:h")) != -1) {
+    if (opt == 't' && parseCount(optarg, threads))
+      continue;
+    else if (opt == 'c')
+      cachePath = optarg;
+    else if (opt == 'g')
+      genomeDir = optarg;
+    else if (opt == 'm')
+      useMemo = true;
+    else if (opt == 'o')
+      outPath = optarg;
+    else {
+      usage(argv[0]);
+      return opt == 'h' ? 0 : 2;
+    }
+  }
+  if (argc - optind > 1) {
+    usage(argv[0]);
+    return 2;
+  }
+
+  FILE *in = stdin;
+  if (optind < argc && strcmp(argv[optind], "-") && (in = fopen(argv[optind], "r")) == NULL) {
+    fprintf(stderr, "%s: cannot read %s\n", argv[0], argv[optind]);
+    return 1;
+  }
+  FILE *out = stdout;
+  if (outPath && (out = fopen(outPath, "w")) == NULL) {
+    fprintf(stderr, "%s: cannot write %s\n", argv[0], outPath);
+    return 1;
+  }
+  ResultCache cache;
+  if (cachePath && !cache.open(cachePath)) {
+    fprintf(stderr, "%s: cannot open cache %s\n", argv[0], cachePath);
+    return 1;
+  }
+
+  ThreadPool pool(threads);
+  PackingMemo memo;
+  Driver d;
+  d.pool = &pool;
+  d.memo = useMemo ? &memo : NULL;
+  d.cache = cachePath ? &cache : NULL;
+  d.genomeCache = genomeDir;
+  d.out = out;
+  d.running = 0;
+  d.jobs = d.failed = 0;
+
+  fprintf(out, "#id\tstatus\tgenes\tcycles\todd_paths\teven_paths\tdistance\tsimilarity\tcached\tload_s\tgraph_s\tpack_s\ttotal_s\n");
+  fflush(out);
+
+  Clock::time_point start = Clock::now();
+  char *line = NULL;
+  size_t capacity = 0;
+  long number = 0;
+  while (getline(&line, &capacity, in) != -1) {
+    Job job;
+    if (!parseJob(line, ++number, job))
+      continue;
+
+    { // read ahead a few jobs per thread only
+      std::unique_lock<std::mutex> guard(d.lock);
+      d.finished.wait(guard, [&d, &pool]() { return d.running < 2 * pool.size(); });
+      d.running++;
+    }
+    pool.submit([job, &d]() {
+        JobResult r;
+        runJob(job, d, r);
+
+        std::lock_guard<std::mutex> guard(d.lock);
+        writeRecord(d.out, job, r);
+        fflush(d.out); // records stream out as jobs finish
+        d.jobs++;
+        d.failed += !r.error.empty();
+        d.running--;
+        d.finished.notify_one();
+      });
+  }
+  free(line);
+  pool.wait();
+
+  fprintf(stderr, "%ld jobs (%ld failed) in %.3fs with %d threads\n", d.jobs, d.failed, lap(start), pool.size());
+  if (in != stdin)
+    fclose(in);
+  if (out != stdout && fclose(out) != 0)
+    return 1;
+
+  return d.failed > 0;
+}
@@ -0,0 +1,267 @@
+/**
+   Copyright (C) 2016 Diego Rubert
+
+   This file is part of the O(k)-approximation algorithm implementation
+   for the DCJ distance on linear unichromosomal genomes in:
+
+   Diego P. Rubert, Pedro Feijão, Marília D. V. Braga, Jens Stoye and Fábio V. Martinez
+   A Linear Time Approximation Algorithm for the DCJ Distance for Genomes with Bounded Number of Duplicates
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdio>
+#include <vector>
+#include <algorithm>
+#include <utility>
+
+#include "graph.hpp"
+#include "thread-pool.hpp"
+#include "gene-matching.hpp"
+
+
+using std::vector;
+
+
+
+/**************************
+ ** GENEMATCHING METHODS **
+ **************************/
+GeneMatching::GeneMatching(Graph *sim) :
+  nA(0),
+  nB(0),
+  maxW(0),
+  total(0),
+  bids(0)
+{
+  if (sim->getN() == 0) {
+    off.assign(1, 0);
+    return;
+  }
+
+  char part = sim->begin()->getPart();
+  vector<int> local(sim->getMaxVertexId() + 1, -1);
+
+  for (auto it = sim->begin(); it != sim->end(); ++it) {
+    if ((*it)->getPart() == part) {
+      local[(*it)->getId()] = nA++;
+      idA.push_back((*it)->getId());
+    }
+    else {
+      local[(*it)->getId()] = nB++;
+      idB.push_back((*it)->getId());
+    }
+  }
+
+  // adjacency of genes of A, duplicated edges merged (heaviest kept)
+  vector<std::pair<int, double>> list;
+  off.assign(nA + 1, 0);
+  for (int i = 0; i < nA; i++) {
+    list.clear();
+    for (auto e : *sim->getVertex(idA[i]))
+      if (e->getAdj()->getPart() != part)
+        list.push_back(std::make_pair(local[e->getAdj()->getId()], e->getWeight()));
+    std::sort(list.begin(), list.end(), [](const std::pair<int, double> &x, const std::pair<int, double> &y) {
+        return x.first != y.first ? x.first < y.first : x.second > y.second;
+      });
+    for (size_t k = 0; k < list.size(); k++)
+      if (k == 0 || list[k].first != list[k-1].first) {
+        adj.push_back(list[k].first);
+        w.push_back(list[k].second);
+        maxW = std::max(maxW, list[k].second);
+      }
+    off[i+1] = (int) adj.size();
+  }
+}
+
+const vector<GenePair> &GeneMatching::greedy(void)
+{
+  vector<int> order(adj.size()), from(adj.size());
+  vector<char> usedA(nA, 0), usedB(nB, 0);
+
+  for (int i = 0; i < nA; i++)
+    for (int k = off[i]; k < off[i+1]; k++)
+      from[k] = i;
+  for (size_t k = 0; k < adj.size(); k++)
+    order[k] = (int) k;
+  std::stable_sort(order.begin(), order.end(), [this](int x, int y) { return w[x] > w[y]; });
+
+  result.clear();
+  total = 0;
+  bids = 0;
+  for (auto k : order)
+    if (w[k] > 0 && !usedA[from[k]] && !usedB[adj[k]]) {
+      usedA[from[k]] = usedB[adj[k]] = 1;
+      result.push_back(GenePair{idA[from[k]], idB[adj[k]], w[k]});
+      total += w[k];
+    }
+
+  return result;
+}
+
+void GeneMatching::runAuction(double tolerance, ThreadPool *pool, vector<int> &owner)
+{
+  int n = nA + nB;
+  vector<int> boff(n + 1, 0), bobj, roff(nB + 1, 0), radj(adj.size());
+  vector<double> bw;
+
+  // doubled problem: bidder i < nA is gene i of A, bidder nA + j is the
+  // mirror of gene j of B; object j < nB is gene j of B, object nB + i
+  // is the mirror of gene i of A
+  for (auto j : adj)
+    roff[j+1]++;
+  for (int j = 0; j < nB; j++)
+    roff[j+1] += roff[j];
+  vector<int> pos(roff.begin(), roff.end() - 1);
+  for (int i = 0; i < nA; i++)
+    for (int k = off[i]; k < off[i+1]; k++)
+      radj[pos[adj[k]]++] = i;
+
+  for (int i = 0; i < nA; i++) {
+    for (int k = off[i]; k < off[i+1]; k++) {
+      bobj.push_back(adj[k]);
+      bw.push_back(w[k]);
+    }
+    bobj.push_back(nB + i);
+    bw.push_back(0);
+    boff[i+1] = (int) bobj.size();
+  }
+  for (int j = 0; j < nB; j++) {
+    bobj.push_back(j);
+    bw.push_back(0);
+    for (int k = roff[j]; k < roff[j+1]; k++) {
+      bobj.push_back(nB + radj[k]);
+      bw.push_back(0);
+    }
+    boff[nA+j+1] = (int) bobj.size();
+  }
+
+  vector<double> price(n, 0), bidVal(n), best(n);
+  vector<int> assigned(n), bidObj(n), winner(n), unassigned, next, touched;
+  double eps = std::max(maxW, 1.0) / 2, last = std::max(maxW, 1e-12) * tolerance / std::max(n, 1);
+
+  // best object of bidder i and its bid (one option: bid enough to keep it)
+  auto bid = [&](int i, int &obj, double &value) {
+    double first = -1e300, second = -1e300;
+    obj = -1;
+    for (int k = boff[i]; k < boff[i+1]; k++) {
+      double v = bw[k] - price[bobj[k]];
+      if (v > first) {
+        second = first;
+        first = v;
+        obj = bobj[k];
+      }
+      else if (v > second)
+        second = v;
+    }
+    value = price[obj] + (second > -1e300 ? first - second : maxW) + eps;
+  };
+
+  for (;;) {
+    owner.assign(n, -1);
+    assigned.assign(n, -1);
+    unassigned.resize(n);
+    for (int i = 0; i < n; i++)
+      unassigned[i] = n - 1 - i; // popped from the back, so bidder 0 first
+
+    if (!pool) { // Gauss-Seidel: one bid at a time
+      while (!unassigned.empty()) {
+        int i = unassigned.back(), j;
+        double value;
+        unassigned.pop_back();
+        bid(i, j, value);
+        bids++;
+        price[j] = value;
+        if (owner[j] >= 0) {
+          assigned[owner[j]] = -1;
+          unassigned.push_back(owner[j]);
+        }
+        owner[j] = i;
+        assigned[i] = j;
+      }
+    }
+    else { // Jacobi: every unassigned bidder bids against the same prices
+      best.assign(n, -1e300);
+      while (!unassigned.empty()) {
+        long u = (long) unassigned.size();
+        pool->parallelFor(0, u, [&](long from, long to, long) {
+            for (long k = from; k < to; k++)
+              bid(unassigned[k], bidObj[k], bidVal[k]);
+          });
+        bids += u;
+
+        touched.clear();
+        for (long k = 0; k < u; k++) { // highest bid wins, ties by order
+          int j = bidObj[k];
+          if (best[j] == -1e300)
+            touched.push_back(j);
+          if (bidVal[k] > best[j]) {
+            best[j] = bidVal[k];
+            winner[j] = unassigned[k];
+          }
+        }
+
+        next.clear();
+        for (auto j : touched) {
+          if (owner[j] >= 0) {
+            assigned[owner[j]] = -1;
+            next.push_back(owner[j]);
+          }
+          owner[j] = winner[j];
+          assigned[winner[j]] = j;
+          price[j] = best[j];
+          best[j] = -1e300;
+        }
+        for (long k = 0; k < u; k++)
+          if (assigned[unassigned[k]] < 0)
+            next.push_back(unassigned[k]);
+        unassigned.swap(next);
+      }
+    }
+
+    if (eps <= last)
+      break;
+    eps = std::max(last, eps / 5);
+  }
+}
+
+const vector<GenePair> &GeneMatching::auction(double tolerance, ThreadPool *pool)
+{
+  vector<int> owner;
+
+  result.clear();
+  total = 0;
+  bids = 0;
+  runAuction(tolerance, pool, owner);
+
+  for (int j = 0; j < nB; j++) {
+    int i = owner[j];
+    if (i < 0 || i >= nA)
+      continue; // taken by a mirror, gene j is unmatched
+    for (int k = off[i]; k < off[i+1]; k++)
+      if (adj[k] == j) {
+        result.push_back(GenePair{idA[i], idB[j], w[k]});
+        total += w[k];
+        break;
+      }
+  }
+
+  return result;
+}
+
+void GeneMatching::print(void) const
+{
+  printf("genes: %d + %d, edges: %zu, matched pairs: %zu, weight: %g, bids: %ld\n",
+         nA, nB, adj.size(), result.size(), total, bids);
+}
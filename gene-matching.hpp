@@ -0,0 +1,115 @@
+/**
+   Copyright (C) 2016 Diego Rubert
+
+   This file is part of the O(k)-approximation algorithm implementation
+   for the DCJ distance on linear unichromosomal genomes in:
+
+   Diego P. Rubert, Pedro Feijão, Marília D. V. Braga, Jens Stoye and Fábio V. Martinez
+   A Linear Time Approximation Algorithm for the DCJ Distance for Genomes with Bounded Number of Duplicates
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+  Maximum weight matching in a bipartite gene similarity graph: a Graph
+  whose vertices are genes, genome A in the part of the first vertex
+  and genome B in the other, and whose edges are weighted by gene
+  similarity. The result (pairs of vertex ids) is meant to select the
+  candidate gene pairs the adjacency graph is built with.
+
+  * greedy(): heaviest edges first, each one taken if both genes are
+    free, a 1/2-approximation in O(m log m)
+  * auction(): Bertsekas' auction algorithm with epsilon scaling. To
+    allow genes to stay unmatched, the graph is doubled into a square
+    assignment problem (the classic mirror reduction): bidders are the
+    genes of A plus a mirror copy of the genes of B, objects are the
+    genes of B plus a mirror copy of the genes of A, every gene may take
+    its own mirror at weight 0 and mirrors are joined (weight 0) where
+    the genes are. A perfect matching always exists and its weight is
+    that of the matching of the original edges it contains. Without a
+    pool, bidders bid one at a time (Gauss-Seidel); with a pool, all
+    unassigned bidders bid in parallel against the same prices and each
+    object goes to its highest bid (Jacobi), which is deterministic.
+    The result is within tolerance * (heaviest edge) of the optimum.
+*/
+
+#ifndef _GENE_MATCHING_HPP
+
+#define _GENE_MATCHING_HPP 1
+
+#include <vector>
+
+#include "graph.hpp"
+#include "thread-pool.hpp"
+
+
+
+/********************
+ ** GENEPAIR CLASS **
+ ********************/
+// A matched pair of genes (similarity graph vertex ids) and its weight
+struct GenePair {
+  int a;          // Gene of genome A
+  int b;          // Gene of genome B
+  double weight;  // Edge weight
+};
+
+
+/************************
+ ** GENEMATCHING CLASS **
+ ************************/
+class GeneMatching {
+private:
+  int nA, nB;                   // Genes in each genome
+  std::vector<int> idA, idB;    // Vertex id of each gene
+  std::vector<int> off, adj;    // Genes of B adjacent to gene i of A: adj[off[i]..off[i+1]-1]
+  std::vector<double> w;        // Weight of each adjacency
+  double maxW;                  // Heaviest edge
+  std::vector<GenePair> result; // Last matching computed
+  double total;                 // Its weight
+  long bids;                    // Bids made by the last auction
+
+  // Runs the auction phases on the doubled problem, fills owner (bidder of each object)
+  void runAuction(double tolerance, ThreadPool *pool, std::vector<int> &owner);
+
+public:
+  // Indexes a similarity graph, O(n + m)
+  GeneMatching(Graph *sim);
+
+  // Computes a greedy matching (1/2-approximation)
+  const std::vector<GenePair> &greedy(void);
+
+  // Computes a matching within tolerance * (heaviest edge) of the
+  // optimum by the auction algorithm, bidding in parallel if pool is given
+  const std::vector<GenePair> &auction(double tolerance = 1e-6, ThreadPool *pool = NULL);
+
+  // Returns the number of genes in each genome
+  inline int getGenesA(void) const { return nA; }
+  inline int getGenesB(void) const { return nB; }
+
+  // Returns the last matching computed
+  inline const std::vector<GenePair> &getMatching(void) const { return result; }
+
+  // Returns its weight
+  inline double getWeight(void) const { return total; }
+
+  // Returns the number of bids of the last auction
+  inline long getBids(void) const { return bids; }
+
+  // Prints a summary of the last matching
+  void print(void) const;
+};
+
+
+#endif /* gene-matching.hpp  */
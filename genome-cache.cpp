@@ -0,0 +1,280 @@
+/**
+   Copyright (C) 2016 Diego Rubert
+
+   This file is part of the O(k)-approximation algorithm implementation
+   for the DCJ distance on linear unichromosomal genomes in:
+
+   Diego P. Rubert, Pedro Feijão, Marília D. V. Braga, Jens Stoye and Fábio V. Martinez
+   A Linear Time Approximation Algorithm for the DCJ Distance for Genomes with Bounded Number of Duplicates
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <vector>
+#include <string>
+#include <atomic>
+#include <unistd.h>
+
+#include "genome.hpp"
+#include "name-index.hpp"
+#include "blast.hpp"
+#include "mapped-file.hpp"
+#include "genome-cache.hpp"
+
+
+using std::vector;
+
+
+
+/*******************
+ ** AUX FUNCTIONS **
+ *******************/
+static const char MAGIC[8] = {'F', 'F', 'D', 'C', 'J', 'G', 'P', '\0'};
+static const uint32_t VERSION = 1, ORDER = 0x01020304;
+
+static_assert(sizeof(SimilarityEdge) == 16, "edges are written as 16-byte records");
+
+// Fixed header of a cache file
+struct CacheHeader {
+  char magic[8];            // MAGIC
+  uint32_t version;         // VERSION
+  uint32_t order;           // ORDER, as written by this machine
+  uint64_t key;             // Key given by the writer
+  uint64_t strings;         // Strings in the table
+  uint64_t stringBytes;     // Bytes of the strings (with their NULs)
+  uint64_t names;           // Leading strings that make up the name index
+  uint64_t genomeName[2];   // String of the name of each genome
+  uint64_t chromosomes[2];  // Chromosomes of each genome
+  uint64_t genes[2];        // Genes of each genome
+  uint64_t edges;           // Similarity edges
+  uint64_t payload;         // Hash of the sections
+};
+
+// Returns n rounded up to a multiple of 8
+static inline size_t padded(size_t n)
+{
+  return (n + 7) & ~(size_t) 7;
+}
+
+// Returns the size of every section described by h, in file order
+static vector<size_t> sections(const CacheHeader &h)
+{
+  vector<size_t> s = {(h.strings + 1) * sizeof(uint64_t), h.stringBytes};
+
+  for (int g = 0; g < 2; g++) {
+    s.push_back((h.chromosomes[g] + 1) * sizeof(int32_t)); // first gene of each chromosome
+    s.push_back(h.chromosomes[g]);                         // circular flags
+    s.push_back(h.genes[g] * sizeof(int32_t));             // families
+    s.push_back(h.genes[g]);                               // strands
+    s.push_back(h.genes[g] * sizeof(int32_t));             // name string ids (-1 = none)
+  }
+  s.push_back(h.edges * sizeof(SimilarityEdge));
+
+  return s;
+}
+
+// Writes a section followed by its padding
+static bool writeSection(FILE *f, const void *data, size_t len)
+{
+  static const char zero[8] = {0};
+
+  return (len == 0 || fwrite(data, 1, len, f) == len) && fwrite(zero, 1, padded(len) - len, f) == padded(len) - len;
+}
+
+static inline uint64_t mix(uint64_t x)
+{
+  x ^= x >> 33;
+  x *= 0xff51afd7ed558ccdULL;
+  x ^= x >> 33;
+  return x;
+}
+
+
+
+/****************************
+ ** GENOME CACHE FUNCTIONS **
+ ****************************/
+uint64_t contentHash(const void *data, size_t len, uint64_t seed)
+{
+  const unsigned char *p = (const unsigned char *) data;
+  uint64_t h = seed ^ mix(len + 0x9e3779b97f4a7c15ULL), w;
+  size_t i;
+
+  for (i = 0; i + 8 <= len; i += 8) { // a word at a time
+    memcpy(&w, p + i, 8);
+    h = (h ^ mix(w)) * 0x9e3779b97f4a7c15ULL;
+    h ^= h >> 29;
+  }
+  for (w = 0; i < len; i++)
+    w = (w << 8) | p[i];
+  return mix(h ^ mix(w + len));
+}
+
+bool hashFile(const char *path, uint64_t &h)
+{
+  MappedFile file;
+
+  if (!file.open(path))
+    return false;
+
+  h = contentHash(file.begin(), file.size(), h);
+  return true;
+}
+
+bool saveGenomePair(const char *path, uint64_t key, const Genome &a, const Genome &b,
+                    const NameIndex &names, const vector<SimilarityEdge> &edges)
+{
+  const Genome *genome[2] = {&a, &b};
+  NameIndex table(names.size() + a.getGenes() + b.getGenes());
+  CacheHeader h;
+
+  // strings: the name index first (same ids), then names of genomes and genes
+  for (int i = 0; i < names.size(); i++)
+    table.insert(names.name(i));
+  vector<int32_t> first[2], family[2], name[2];
+  vector<uint8_t> circular[2], reverse[2];
+  for (int g = 0; g < 2; g++) {
+    h.genomeName[g] = table.insert(genome[g]->getName());
+    h.chromosomes[g] = genome[g]->getChromosomes();
+    h.genes[g] = genome[g]->getGenes();
+    for (int c = 0; c < genome[g]->getChromosomes(); c++) {
+      first[g].push_back(genome[g]->chromosomeBegin(c));
+      circular[g].push_back(genome[g]->isCircular(c));
+    }
+    first[g].push_back(genome[g]->getGenes());
+    for (int i = 0; i < genome[g]->getGenes(); i++) {
+      family[g].push_back(genome[g]->getGene(i).family);
+      reverse[g].push_back(genome[g]->getGene(i).reverse);
+      name[g].push_back(*genome[g]->getGeneName(i) ? table.insert(genome[g]->getGeneName(i)) : -1);
+    }
+  }
+
+  vector<uint64_t> offset(1, 0);
+  vector<char> bytes;
+  for (int i = 0; i < table.size(); i++) {
+    const char *s = table.name(i);
+    bytes.insert(bytes.end(), s, s + strlen(s) + 1);
+    offset.push_back(bytes.size());
+  }
+
+  memcpy(h.magic, MAGIC, sizeof(MAGIC));
+  h.version = VERSION;
+  h.order = ORDER;
+  h.key = key;
+  h.strings = table.size();
+  h.stringBytes = bytes.size();
+  h.names = names.size();
+  h.edges = edges.size();
+  h.payload = 0;
+
+  // the payload hash goes in the header, so it's computed first
+  const void *data[] = {offset.data(), bytes.data(),
+                        first[0].data(), circular[0].data(), family[0].data(), reverse[0].data(), name[0].data(),
+                        first[1].data(), circular[1].data(), family[1].data(), reverse[1].data(), name[1].data(),
+                        edges.data()};
+  vector<size_t> len = sections(h);
+  for (size_t s = 0; s < len.size(); s++)
+    h.payload = contentHash(data[s], len[s], h.payload);
+
+  static std::atomic<unsigned> writes(0); // temporary names are unique, so writers of one path don't clash
+  std::string tmp = std::string(path) + "." + std::to_string(getpid()) + "." + std::to_string(writes++) + ".tmp";
+  FILE *f = fopen(tmp.c_str(), "wb");
+  if (f == NULL)
+    return false;
+
+  bool ok = fwrite(&h, sizeof(h), 1, f) == 1;
+  for (size_t s = 0; ok && s < len.size(); s++)
+    ok = writeSection(f, data[s], len[s]);
+  ok = fclose(f) == 0 && ok;
+
+  if (!ok || rename(tmp.c_str(), path) != 0) {
+    unlink(tmp.c_str());
+    return false;
+  }
+  return true;
+}
+
+bool loadGenomePair(const char *path, uint64_t key, Genome &a, Genome &b,
+                    NameIndex &names, vector<SimilarityEdge> &edges)
+{
+  MappedFile file;
+  CacheHeader h;
+
+  if (!file.open(path) || file.size() < sizeof(h))
+    return false;
+
+  memcpy(&h, file.begin(), sizeof(h));
+  if (memcmp(h.magic, MAGIC, sizeof(MAGIC)) != 0 || h.version != VERSION || h.order != ORDER || h.key != key)
+    return false;
+
+  // sizes first (so a damaged header can't make us read past the end), then the hash
+  vector<size_t> len = sections(h);
+  vector<const char *> data;
+  size_t total = sizeof(h);
+  for (auto l : len) {
+    if (l > file.size())
+      return false;
+    data.push_back(file.begin() + total);
+    total += padded(l);
+  }
+  if (total != file.size())
+    return false;
+
+  uint64_t hash = 0;
+  for (size_t s = 0; s < len.size(); s++)
+    hash = contentHash(data[s], len[s], hash);
+  if (hash != h.payload)
+    return false;
+
+  const uint64_t *offset = (const uint64_t *) data[0];
+  const char *bytes = data[1];
+  if (offset[h.strings] != h.stringBytes || h.names > h.strings)
+    return false;
+
+  NameIndex index(h.names);
+  for (uint64_t i = 0; i < h.names; i++)
+    index.insert(bytes + offset[i]);
+
+  Genome genome[2];
+  for (int g = 0; g < 2; g++) {
+    const int32_t *first = (const int32_t *) data[2 + 5 * g], *family = (const int32_t *) data[4 + 5 * g];
+    const int32_t *name = (const int32_t *) data[6 + 5 * g];
+    const uint8_t *circular = (const uint8_t *) data[3 + 5 * g], *reverse = (const uint8_t *) data[5 + 5 * g];
+
+    if (h.genomeName[g] >= h.strings || first[0] != 0 || (uint64_t) first[h.chromosomes[g]] != h.genes[g])
+      return false;
+
+    genome[g].setName(bytes + offset[h.genomeName[g]]);
+    for (uint64_t c = 0; c < h.chromosomes[g]; c++) {
+      if (first[c+1] < first[c])
+        return false;
+      genome[g].addChromosome(circular[c]);
+      for (int32_t i = first[c]; i < first[c+1]; i++) {
+        if (name[i] >= (int64_t) h.strings)
+          return false;
+        genome[g].addGene(family[i], reverse[i], name[i] >= 0 ? bytes + offset[name[i]] : NULL);
+      }
+    }
+  }
+
+  const SimilarityEdge *e = (const SimilarityEdge *) data[12];
+  edges.assign(e, e + h.edges);
+  a = genome[0];
+  b = genome[1];
+  names = index;
+  return true;
+}
@@ -0,0 +1,79 @@
+/**
+   Copyright (C) 2016 Diego Rubert
+
+   This file is part of the O(k)-approximation algorithm implementation
+   for the DCJ distance on linear unichromosomal genomes in:
+
+   Diego P. Rubert, Pedro Feijão, Marília D. V. Braga, Jens Stoye and Fábio V. Martinez
+   A Linear Time Approximation Algorithm for the DCJ Distance for Genomes with Bounded Number of Duplicates
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+  Binary cache of a preprocessed genome pair: both genomes (chromosomes,
+  families, strands and gene names), the gene name index and the
+  filtered similarity edges, so later runs skip parsing and go straight
+  to graph construction. A cache file is valid for a key, a content
+  hash of the source files and of whatever options shaped the data
+  (filters), chosen by the caller.
+
+  Layout (native byte order, checked through a tag in the header): a
+  fixed header with the key, the counts and a hash of the payload,
+  then 8-byte aligned sections: the string table (offsets then NUL
+  terminated strings; the first entries are the name index, in id
+  order), chromosome starts and kinds, and gene families, strands and
+  name ids of each genome, and the edges as SimilarityEdge records.
+  Files are written to a temporary name (unique to the writer) and
+  renamed, so readers never see partial files and concurrent writers
+  of one file don't clash, and are memory mapped and verified when
+  loaded.
+*/
+
+#ifndef _GENOME_CACHE_HPP
+
+#define _GENOME_CACHE_HPP 1
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "genome.hpp"
+#include "name-index.hpp"
+#include "blast.hpp"
+
+
+
+/****************************
+ ** GENOME CACHE FUNCTIONS **
+ ****************************/
+// Returns a 64-bit hash of [data, data + len), chained through seed
+uint64_t contentHash(const void *data, size_t len, uint64_t seed = 0);
+
+// Chains the content hash of the file at path into h, returns false
+// if it can't be read
+bool hashFile(const char *path, uint64_t &h);
+
+// Writes a genome pair (and the similarity edges between names) to a
+// cache file for key, returns false on error
+bool saveGenomePair(const char *path, uint64_t key, const Genome &a, const Genome &b,
+                    const NameIndex &names, const std::vector<SimilarityEdge> &edges);
+
+// Loads a genome pair from a cache file, returns false (leaving the
+// arguments unchanged) if the file is missing, damaged or has another key
+bool loadGenomePair(const char *path, uint64_t key, Genome &a, Genome &b,
+                    NameIndex &names, std::vector<SimilarityEdge> &edges);
+
+
+#endif /* genome-cache.hpp  */
@@ -0,0 +1,175 @@
+/**
+   Copyright (C) 2016 Diego Rubert
+
+   This file is part of the O(k)-approximation algorithm implementation
+   for the DCJ distance on linear unichromosomal genomes in:
+
+   Diego P. Rubert, Pedro Feijão, Marília D. V. Braga, Jens Stoye and Fábio V. Martinez
+   A Linear Time Approximation Algorithm for the DCJ Distance for Genomes with Bounded Number of Duplicates
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "genome.hpp"
+#include "name-index.hpp"
+#include "thread-pool.hpp"
+#include "input-file.hpp"
+#include "genome-parser.hpp"
+
+
+using std::vector;
+
+
+
+/*******************
+ ** AUX FUNCTIONS **
+ *******************/
+// Returns whether c ends a gene name
+static inline bool separator(char c)
+{
+  return (unsigned char) c <= ' ' || c == '|' || c == ')' || c == '$' || c == '#';
+}
+
+// Returns the end of the gene name starting at p
+static const char *nameEnd(const char *p, const char *end)
+{
+#if defined(__SSE2__)
+  const __m128i space = _mm_set1_epi8(' '), bar = _mm_set1_epi8('|'), paren = _mm_set1_epi8(')');
+  const __m128i dollar = _mm_set1_epi8('$'), hash = _mm_set1_epi8('#');
+
+  for (; p + 16 <= end; p += 16) {
+    __m128i x = _mm_loadu_si128((const __m128i *) p);
+    __m128i hit = _mm_cmpeq_epi8(_mm_max_epu8(x, space), space); // x <= ' ' (unsigned)
+    hit = _mm_or_si128(hit, _mm_or_si128(_mm_cmpeq_epi8(x, bar), _mm_cmpeq_epi8(x, paren)));
+    hit = _mm_or_si128(hit, _mm_or_si128(_mm_cmpeq_epi8(x, dollar), _mm_cmpeq_epi8(x, hash)));
+    int mask = _mm_movemask_epi8(hit);
+    if (mask)
+      return p + __builtin_ctz(mask);
+  }
+#endif
+
+  while (p < end && !separator(*p))
+    p++;
+  return p;
+}
+
+// Returns the end of the line at p (its newline or end)
+static inline const char *lineEnd(const char *p, const char *end)
+{
+  const char *eol = (const char *) memchr(p, '\n', end - p);
+  return eol ? eol : end;
+}
+
+
+
+/**************************
+ ** GENOMEPARSER METHODS **
+ **************************/
+GenomeParser::GenomeParser(NameIndex *families) :
+  families(families),
+  genes(0),
+  chromosomes(0),
+  malformed(0)
+{
+}
+
+int GenomeParser::parse(const char *begin, const char *end, vector<Genome> &genomes)
+{
+  size_t first = genomes.size();
+  Genome *g = NULL;
+  bool open = false; // whether the last chromosome of g takes more genes
+
+  for (const char *p = begin; p < end; ) {
+    char c = *p;
+
+    if (c == '\n' || c == '|' || c == '$') { // end of a linear chromosome
+      open = false;
+      p++;
+    }
+    else if (c == ')') {
+      if (open)
+        g->setCircular(g->getChromosomes() - 1);
+      open = false;
+      p++;
+    }
+    else if ((unsigned char) c <= ' ')
+      p++;
+    else if (c == '#')
+      p = lineEnd(p, end);
+    else if (c == '>') { // header: the rest of the line, trimmed
+      const char *q = lineEnd(p, end), *s = p + 1;
+      while (s < q && (unsigned char) *s <= ' ')
+        s++;
+      while (q > s && (unsigned char) q[-1] <= ' ')
+        q--;
+      genomes.push_back(Genome(std::string(s, q).c_str()));
+      g = &genomes.back();
+      open = false;
+      p = lineEnd(p, end);
+    }
+    else { // gene
+      bool reverse = c == '-';
+      if (c == '-' || c == '+')
+        p++;
+
+      const char *q = nameEnd(p, end);
+      if (q == p) {
+        malformed++;
+        continue;
+      }
+
+      if (g == NULL) {
+        genomes.push_back(Genome());
+        g = &genomes.back();
+      }
+      if (!open) {
+        g->addChromosome();
+        chromosomes++;
+        open = true;
+      }
+
+      int id = families->insert(p, q - p);
+      g->addGene(id + 1, reverse, families->name(id));
+      genes++;
+      p = q;
+    }
+  }
+
+  return (int) (genomes.size() - first);
+}
+
+bool GenomeParser::parseFile(const char *path, vector<Genome> &genomes, ThreadPool *pool)
+{
+  InputFile file;
+  const char *begin, *end;
+
+  if (!file.open(path) || !file.read(begin, end, pool))
+    return false;
+
+  parse(begin, end, genomes);
+  return true;
+}
+
+void GenomeParser::print(void) const
+{
+  printf("%ld genes in %ld chromosomes read, %ld malformed tokens\n", genes, chromosomes, malformed);
+}
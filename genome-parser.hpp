@@ -0,0 +1,91 @@
+/**
+   Copyright (C) 2016 Diego Rubert
+
+   This file is part of the O(k)-approximation algorithm implementation
+   for the DCJ distance on linear unichromosomal genomes in:
+
+   Diego P. Rubert, Pedro Feijão, Marília D. V. Braga, Jens Stoye and Fábio V. Martinez
+   A Linear Time Approximation Algorithm for the DCJ Distance for Genomes with Bounded Number of Duplicates
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+  Parser of gene order files in UniMoG/GRIMM style:
+
+    >genome name
+    a -b c |        linear chromosome ('|' or '$')
+    d e )           circular chromosome
+    # comment
+
+  Genes are whitespace separated names, reverse strand if prefixed by
+  '-' ('+' is optional). A chromosome ends at its marker or at the end
+  of its line (linear). Genes before the first header go to a genome
+  with no name. Each gene name is a family: family ids are the ids of a
+  NameIndex (shared by the genomes of a comparison) plus one, so genes
+  go straight to Genome arrays ready for buildAdjacencyGraph().
+
+  Plain files are memory mapped (compressed ones decompressed, see
+  input-file.hpp) and tokenized in place: the end of every gene name
+  (next blank, marker or comment) is found 16 bytes at a time with
+  SSE2 compares and a movemask (with a scalar fallback without SSE2,
+  and for the last bytes), so names are never copied unless new to
+  the index.
+*/
+
+#ifndef _GENOME_PARSER_HPP
+
+#define _GENOME_PARSER_HPP 1
+
+#include <vector>
+
+#include "genome.hpp"
+#include "name-index.hpp"
+#include "thread-pool.hpp"
+
+
+
+/************************
+ ** GENOMEPARSER CLASS **
+ ************************/
+class GenomeParser {
+private:
+  NameIndex *families; // Family ids of gene names (minus one)
+  long genes;          // Genes read
+  long chromosomes;    // Chromosomes read
+  long malformed;      // Tokens skipped (signs without a name)
+
+public:
+  // Receives the index family names are resolved with
+  GenomeParser(NameIndex *families);
+
+  // Parses the genomes in [begin, end), appending them to genomes,
+  // returns the number of genomes appended
+  int parse(const char *begin, const char *end, std::vector<Genome> &genomes);
+
+  // Reads (see input-file.hpp, gzip/BGZF are decompressed, on pool if
+  // any) and parses a whole file, returns false if it can't be read
+  bool parseFile(const char *path, std::vector<Genome> &genomes, ThreadPool *pool = NULL);
+
+  // Returns the number of genes, chromosomes and malformed tokens read
+  inline long getGenes(void) const { return genes; }
+  inline long getChromosomes(void) const { return chromosomes; }
+  inline long getMalformed(void) const { return malformed; }
+
+  // Prints a summary
+  void print(void) const;
+};
+
+
+#endif /* genome-parser.hpp  */
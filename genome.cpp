@@ -0,0 +1,94 @@
+/**
+   Copyright (C) 2016 Diego Rubert
+
+   This file is part of the O(k)-approximation algorithm implementation
+   for the DCJ distance on linear unichromosomal genomes in:
+
+   Diego P. Rubert, Pedro Feijão, Marília D. V. Braga, Jens Stoye and Fábio V. Martinez
+   A Linear Time Approximation Algorithm for the DCJ Distance for Genomes with Bounded Number of Duplicates
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include "genome.hpp"
+
+
+using std::vector;
+
+
+
+/********************
+ ** GENOME METHODS **
+ ********************/
+Genome::Genome(const char *name) :
+  name(name ? name : ""),
+  nameBytes(1, '\0'),
+  first(1, 0),
+  maxFamily(0)
+{
+}
+
+void Genome::clear(void)
+{
+  genes.clear();
+  nameBytes.assign(1, '\0');
+  names.clear();
+  first.assign(1, 0);
+  circular.clear();
+  maxFamily = 0;
+}
+
+int Genome::addChromosome(bool circular)
+{
+  this->circular.push_back(circular);
+  first.push_back(first.back());
+  return (int) this->circular.size() - 1;
+}
+
+int Genome::addGene(int family, bool reverse, const char *name)
+{
+  if (circular.empty())
+    addChromosome();
+
+  genes.push_back(Gene{family, reverse, (int) circular.size() - 1});
+  if (name && *name) {
+    names.push_back(nameBytes.size());
+    nameBytes.insert(nameBytes.end(), name, name + strlen(name) + 1);
+  }
+  else
+    names.push_back(0);
+  first.back()++;
+  maxFamily = std::max(maxFamily, family);
+  return (int) genes.size() - 1;
+}
+
+void Genome::print(void) const
+{
+  printf(">%s\n", name.c_str());
+  for (int c = 0; c < getChromosomes(); c++) {
+    for (int i = first[c]; i < first[c+1]; i++) {
+      if (names[i] == 0)
+        printf("%s%d ", genes[i].reverse ? "-" : "", genes[i].family);
+      else
+        printf("%s%s ", genes[i].reverse ? "-" : "", &nameBytes[names[i]]);
+    }
+    printf("%s\n", circular[c] ? ")" : "|");
+  }
+}
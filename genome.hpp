@@ -0,0 +1,113 @@
+/**
+   Copyright (C) 2016 Diego Rubert
+
+   This file is part of the O(k)-approximation algorithm implementation
+   for the DCJ distance on linear unichromosomal genomes in:
+
+   Diego P. Rubert, Pedro Feijão, Marília D. V. Braga, Jens Stoye and Fábio V. Martinez
+   A Linear Time Approximation Algorithm for the DCJ Distance for Genomes with Bounded Number of Duplicates
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+  Genomes as ordered gene contents, the input the adjacency graph is
+  built from. A genome is a list of chromosomes (linear or circular),
+  each one a run of consecutive genes; every gene has a family id
+  (0 = no family, e.g. for family-free comparisons), a strand and an
+  optional name. Genes are indexed from 0 in genome order.
+*/
+
+#ifndef _GENOME_HPP
+
+#define _GENOME_HPP 1
+
+#include <string>
+#include <vector>
+
+
+
+/****************
+ ** GENE CLASS **
+ ****************/
+// A gene of a genome
+struct Gene {
+  int family;     // Family id (0 = none)
+  bool reverse;   // Whether the gene is read on the reverse strand
+  int chromosome; // Chromosome index
+};
+
+
+/******************
+ ** GENOME CLASS **
+ ******************/
+class Genome {
+private:
+  std::string name;               // Genome name
+  std::vector<Gene> genes;        // Genes in genome order
+  std::vector<char> nameBytes;    // Gene names, each followed by a NUL (starts with "")
+  std::vector<size_t> names;      // Start of the name of each gene (0 = none)
+  std::vector<int> first;         // First gene of each chromosome (plus the number of genes)
+  std::vector<char> circular;     // Whether each chromosome is circular
+  int maxFamily;                  // Greatest family id
+
+public:
+  // Creates an empty genome
+  Genome(const char *name = 0x0);
+
+  // Returns/sets the genome name
+  inline const char *getName(void) const { return name.c_str(); }
+  inline void setName(const char *name) { this->name = name ? name : ""; }
+
+  // Removes every chromosome
+  void clear(void);
+
+  // Starts a new empty chromosome, returning its index
+  int addChromosome(bool circular = false);
+
+  // Appends a gene to the last chromosome (a linear one is started if
+  // there is none), returning its index
+  int addGene(int family, bool reverse = false, const char *name = 0x0);
+
+  // Returns the number of genes
+  inline int getGenes(void) const { return (int) genes.size(); }
+
+  // Returns gene i
+  inline const Gene &getGene(int i) const { return genes[i]; }
+
+  // Returns the name of gene i ("" = none)
+  inline const char *getGeneName(int i) const { return &nameBytes[names[i]]; }
+
+  // Returns the greatest family id
+  inline int getMaxFamily(void) const { return maxFamily; }
+
+  // Returns the number of chromosomes
+  inline int getChromosomes(void) const { return (int) circular.size(); }
+
+  // Returns the first gene of chromosome c and the one after its last
+  inline int chromosomeBegin(int c) const { return first[c]; }
+  inline int chromosomeEnd(int c) const { return first[c+1]; }
+
+  // Returns whether chromosome c is circular
+  inline bool isCircular(int c) const { return circular[c]; }
+
+  // Sets whether chromosome c is circular
+  inline void setCircular(int c, bool circular = true) { this->circular[c] = circular; }
+
+  // Prints the genome, one chromosome per line (UniMoG-like)
+  void print(void) const;
+};
+
+
+#endif /* genome.hpp  */
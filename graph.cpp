@@ -22,11 +22,15 @@
 */
 
 #include "graph.hpp"
+#include "thread-pool.hpp"
 
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <iterator>
+#include <atomic>
+#include <algorithm>
+#include <functional>
 #include <string.h>
 
 /*********************
@@ -64,7 +68,8 @@ Edge::Edge(Vertex *adj, const char *label) :
   label(NULL),
   ex1(0, Extremity::Type::UNDEF),
   ex2(0, Extremity::Type::UNDEF),
-  sibling(NULL)
+  sibling(NULL),
+  weight(1.0)
 {
   setLabel(label);
 }
@@ -149,6 +154,11 @@ Edge *Edge::getSibling(void)
   return sibling;
 }
 
+void Edge::setWeight(double weight)
+{
+  this->weight = adjRef->weight = weight;
+}
+
 bool Edge::incident(Vertex *v)
 {
   if (adj == v)
@@ -319,13 +329,15 @@ Graph::Graph(Graph &g) :
         Extremity e1 = e->getExtremityFrom();
         Extremity e2 = e->getExtremityTo();
         newe->setExtremities(e1.getId(), e1.getType(), e2.getId(), e2.getType()); // must use this function to add extremities to crossref
+        newe->setWeight(e->weight);
 
         if (sibling) {
           Edge *newe_sibling = addEdge(sibling->adjRef->adj->id, sibling->adj->id, sibling->label);
 
-          e1 = e->getExtremityFrom();
-          e2 = e->getExtremityTo();
+          e1 = sibling->getExtremityFrom();
+          e2 = sibling->getExtremityTo();
           newe_sibling->setExtremities(e1.getId(), e1.getType(), e2.getId(), e2.getType());
+          newe_sibling->setWeight(sibling->weight);
 
           newe->setSibling(newe_sibling);
           newe_sibling->setSibling(newe);
@@ -425,6 +437,80 @@ Edge *Graph::addEdge(Vertex *v1, Vertex *v2, const char *label)
   return e1;
 }
 
+void Graph::addEdges(const std::vector<std::pair<int, int> > &ends, std::vector<Edge *> &added, ThreadPool *pool)
+{
+  long count = ends.size();
+  std::vector<int> off(maxn + 1, 0);
+  std::vector<long> slot;                    // 2k (edge k at v1) or 2k + 1 (at v2), by vertex
+  std::atomic<int> *cursor = new std::atomic<int>[maxn];
+  std::atomic<long> valid(0);
+
+  auto forRange = [pool](long n, const std::function<void(long, long, long)> &body) {
+    if (pool)
+      pool->parallelFor(0, n, body);
+    else
+      body(0, n, 0);
+  };
+
+  // allocate both objects of every edge and count them at their endpoints
+  for (int id = 0; id < maxn; id++)
+    cursor[id] = 0;
+  added.assign(count, NULL);
+  forRange(count, [&](long from, long to, long) {
+      for (long k = from; k < to; k++) {
+        int id1 = ends[k].first, id2 = ends[k].second;
+        Vertex *v1 = id1 >= 0 && id1 < maxn ? vertices[id1] : NULL, *v2 = id2 >= 0 && id2 < maxn ? vertices[id2] : NULL;
+        if (v1 == v2 || v1 == NULL || v2 == NULL) // as addEdge
+          continue;
+        Edge *e1 = new Edge(v2), *e2 = new Edge(v1);
+        e1->adjRef = e2;
+        e2->adjRef = e1;
+        added[k] = e1;
+        cursor[v1->id]++;
+        cursor[v2->id]++;
+        valid++;
+      }
+    });
+
+  for (int id = 0; id < maxn; id++) {
+    off[id+1] = off[id] + cursor[id];
+    cursor[id] = 0;
+  }
+  slot.resize(off[maxn]);
+  forRange(count, [&](long from, long to, long) {
+      for (long k = from; k < to; k++)
+        if (added[k]) {
+          slot[off[ends[k].first] + cursor[ends[k].first]++] = 2 * k;
+          slot[off[ends[k].second] + cursor[ends[k].second]++] = 2 * k + 1;
+        }
+    });
+
+  // addEdge pushes to the front: the last edge added comes first
+  forRange(maxn, [&](long from, long to, long) {
+      for (long id = from; id < to; id++) {
+        if (off[id] == off[id+1])
+          continue;
+        std::sort(slot.begin() + off[id], slot.begin() + off[id+1], std::greater<long>());
+
+        Vertex *v = vertices[id];
+        Edge *prev = v->edges, *old = v->edges->next;
+        for (int i = off[id]; i < off[id+1]; i++) {
+          Edge *e = slot[i] & 1 ? added[slot[i] / 2]->adjRef : added[slot[i] / 2];
+          prev->next = e;
+          e->prev = prev;
+          prev = e;
+        }
+        prev->next = old;
+        if (old)
+          old->prev = prev;
+        v->degree += off[id+1] - off[id];
+      }
+    });
+
+  m += valid;
+  delete[] cursor;
+}
+
 Vertex *Graph::addVertex(const char *label, char part, unsigned int family)
 {
   int id;
@@ -41,12 +41,14 @@
 
 #include <iterator>
 #include <vector>
+#include <utility>
 
 
 /* Some forward-declaration */
 class Edge;
 class Vertex;
 class Graph;
+class ThreadPool;
 
 
 /*********************
@@ -78,6 +80,9 @@ public:
   /* Returns the type of the extremity: tail, head or undefined (used in null extremities) */
   inline Type getType(void) const { return t; }
 
+  /* Returns an index for flat arrays (2 * id, + 1 if head), or -1 if undefined */
+  inline int index(void) const { return t == UNDEF ? -1 : 2 * id + (t == HEAD); }
+
   /* == operator overload */
   inline bool operator==(const Extremity &other) const {
     return (id == other.id && t == other.t) || (t == UNDEF && other.t == UNDEF);
@@ -114,6 +119,7 @@ private:
   Extremity ex1; /* Extremity of vertex where this edge is stored */
   Extremity ex2; /* Extremity of adjacent vertex to the one this edge is stored */
   Edge *sibling; /* Stores this edge's sibling (used on adjacency graph) */
+  double weight; /* Edge weight (e.g. gene similarity on adjacency graph), 1 by default */
 
 public:
   /* Default constructor */
@@ -160,6 +166,12 @@ public:
   /* Gets this edge's sibling */
   Edge *getSibling(void);
 
+  /* Returns the weight */
+  inline double getWeight(void) const { return weight; }
+
+  /* Sets the weight (of both objects representing this edge) */
+  void setWeight(double weight);
+
   /* Returns true if this edge is incident to v */
   bool incident(Vertex *v);
 
@@ -192,7 +204,7 @@ public:
 
 private:
   int id;                     /* Vertex id (should be equal to array index) */
-  unsigned short degree;      /* Vertex degree, optional */
+  int degree;                 /* Vertex degree, optional */
   char direction;             /* Gene direction, optional (1: -->, -1: <--, 0: unoriented */
   unsigned char part;         /* Which part of graph this vertex belongs, optional */
   unsigned short family;      /* Family id, 0 = no family */
@@ -349,6 +361,16 @@ public:
   /* Add an edge, returning it (v1 to v2) if added or NULL */
   Edge *addEdge(Vertex *v1, Vertex *v2, const char *label = 0x0);
 
+  /*
+    Add many edges (unlabeled), the k-th one from vertex id ends[k].first
+    to ends[k].second, optionally on a thread pool. Edges are allocated
+    in parallel, incident edges of each vertex are counted, laid out by
+    a prefix sum and sorted, and lists are linked vertex by vertex, so
+    the graph is exactly the one given by calling addEdge in order.
+    added[k] is the k-th edge (v1 to v2) or NULL if not added.
+  */
+  void addEdges(const std::vector<std::pair<int, int> > &ends, std::vector<Edge *> &added, ThreadPool *pool = 0x0);
+
   /* Remove edge from graph */
   void removeEdge(Edge *e);
 
@@ -0,0 +1,133 @@
+/**
+   Copyright (C) 2016 Diego Rubert
+
+   This file is part of the O(k)-approximation algorithm implementation
+   for the DCJ distance on linear unichromosomal genomes in:
+
+   Diego P. Rubert, Pedro Feijão, Marília D. V. Braga, Jens Stoye and Fábio V. Martinez
+   A Linear Time Approximation Algorithm for the DCJ Distance for Genomes with Bounded Number of Duplicates
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdio>
+#include <vector>
+#include <queue>
+#include <forward_list>
+#include <algorithm>
+
+#include "graph.hpp"
+#include "paths-cycles.hpp"
+#include "decomposition.hpp"
+#include "greedy-similarity.hpp"
+
+
+using std::vector;
+
+
+
+/******************************
+ ** GREEDYSIMILARITY METHODS **
+ ******************************/
+GreedySimilarity::GreedySimilarity(Graph *ag, int maxLen) :
+  ag(ag),
+  maxLen(maxLen),
+  dec(ag),
+  result(),
+  enumerated(0),
+  taken(0),
+  discarded(0)
+{
+  int k = 0;
+
+  for (int id = 0; id < dec.getMaxGeneId(); id++)
+    k = std::max(k, dec.candidates(id));
+
+  if (this->maxLen <= 0)
+    this->maxLen = 2 * k;
+}
+
+bool GreedySimilarity::compatible(Path *c) const
+{
+  for (int i = 0; i < c->lenE(); i++) {
+    int from = c->nthE(i)->getExtremityFrom().index(), to = c->nthE(i)->getExtremityTo().index();
+    if ((from >= 0 && occupied[from]) || (to >= 0 && occupied[to]))
+      return false;
+  }
+
+  return dec.consistent(c);
+}
+
+void GreedySimilarity::take(Path *c)
+{
+  for (int i = 0; i < c->lenE(); i++) {
+    int from = c->nthE(i)->getExtremityFrom().index(), to = c->nthE(i)->getExtremityTo().index();
+    if (from >= 0)
+      occupied[from] = 1;
+    if (to >= 0)
+      occupied[to] = 1;
+  }
+
+  dec.add(c);
+}
+
+void GreedySimilarity::run(bool complete)
+{
+  struct Entry {
+    double score;
+    int len;
+    Path *c;
+    bool operator<(const Entry &o) const { return score != o.score ? score < o.score : len > o.len; }
+  };
+  std::priority_queue<Entry> heap;
+  std::forward_list<Path *> cycles;
+
+  dec.clear();
+  occupied.assign(2 * dec.getMaxGeneId(), 0);
+  enumerated = taken = discarded = 0;
+
+  for (int len = 2; len <= maxLen; len += 2) {
+    enumerateCycles(ag, len, &cycles);
+    for (auto c : cycles) {
+      double w = 0;
+      for (int i = 0; i < c->lenE(); i++)
+        w += c->nthE(i)->getWeight();
+      heap.push(Entry{w / c->lenE(), c->lenE(), c});
+      enumerated++;
+    }
+    cycles.clear();
+  }
+
+  while (!heap.empty()) {
+    Path *c = heap.top().c;
+    heap.pop();
+    if (compatible(c)) {
+      take(c);
+      taken++;
+    }
+    else
+      discarded++;
+    delete c;
+  }
+
+  if (complete)
+    dec.complete();
+  result = dec.score();
+}
+
+void GreedySimilarity::print(void) const
+{
+  printf("%ld cycles enumerated (up to length %d), %ld taken, %ld discarded\n", enumerated, maxLen, taken, discarded);
+  result.print();
+}
@@ -0,0 +1,103 @@
+/**
+   Copyright (C) 2016 Diego Rubert
+
+   This file is part of the O(k)-approximation algorithm implementation
+   for the DCJ distance on linear unichromosomal genomes in:
+
+   Diego P. Rubert, Pedro Feijão, Marília D. V. Braga, Jens Stoye and Fábio V. Martinez
+   A Linear Time Approximation Algorithm for the DCJ Distance for Genomes with Bounded Number of Duplicates
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+  Greedy heuristic for the family-free DCJ similarity: every consistent
+  cycle of length 2, 4, ..., maxLen is enumerated once and pushed to a
+  max-heap keyed by its normalized weight w(C)/|C| (sum of edge weights
+  over number of edges, ties by shorter cycles). The best cycle is
+  popped repeatedly and taken if it is still compatible with the ones
+  taken before; otherwise it is just discarded (lazy invalidation).
+
+  Compatibility is checked in O(|C|) on flat arrays indexed by gene
+  extremity (Extremity::index) instead of conflict edges: an extremity
+  may be covered by a single edge of the decomposition (occupancy) and
+  both genes of every edge must be free or matched to each other
+  (Decomposition::consistent). No CyclesGraph is ever built, so memory
+  is linear in the number of cycles. The adjacency graph is only read.
+*/
+
+#ifndef _GREEDY_SIMILARITY_HPP
+
+#define _GREEDY_SIMILARITY_HPP 1
+
+#include <vector>
+
+#include "graph.hpp"
+#include "paths-cycles.hpp"
+#include "decomposition.hpp"
+
+
+
+/****************************
+ ** GREEDYSIMILARITY CLASS **
+ ****************************/
+class GreedySimilarity {
+private:
+  Graph *ag;                  // Adjacency graph
+  int maxLen;                 // Length of the longest cycles enumerated
+  Decomposition dec;          // Gene matching being built
+  DCJScore result;            // Scores of the final decomposition
+  std::vector<char> occupied; // Whether each gene extremity is covered by a taken cycle
+  long enumerated;            // Cycles enumerated
+  long taken;                 // Cycles taken
+  long discarded;             // Cycles popped and discarded
+
+  // Returns true if c may be taken
+  bool compatible(Path *c) const;
+
+  // Takes c
+  void take(Path *c);
+
+public:
+  // Receives the adjacency graph and the length of the longest cycles
+  // (0 = 2k, where k is the size of the largest family)
+  GreedySimilarity(Graph *ag, int maxLen = 0);
+
+  // Runs the greedy and scores the decomposition, completing it first
+  // (matching genes left free to their heaviest free candidates) if asked
+  void run(bool complete = true);
+
+  // Returns the length of the longest cycles enumerated
+  inline int getMaxLen(void) const { return maxLen; }
+
+  // Returns the number of cycles enumerated, taken and discarded
+  inline long getEnumerated(void) const { return enumerated; }
+  inline long getTaken(void) const { return taken; }
+  inline long getDiscarded(void) const { return discarded; }
+
+  // Returns the gene matched to gene id (0 = unmatched)
+  inline int getMate(int id) const { return id < dec.getMaxGeneId() ? dec.getMate(id) : 0; }
+
+  // Returns the scores of the decomposition
+  inline const DCJScore &getScore(void) const { return result; }
+
+  // Returns the DCJ similarity of the decomposition
+  inline double similarity(void) const { return result.similarity; }
+
+  // Prints a summary of the run and of the decomposition
+  void print(void) const;
+};
+
+
+#endif /* greedy-similarity.hpp  */
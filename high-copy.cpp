@@ -0,0 +1,205 @@
+/**
+   Copyright (C) 2016 Diego Rubert
+
+   This file is part of the O(k)-approximation algorithm implementation
+   for the DCJ distance on linear unichromosomal genomes in:
+
+   Diego P. Rubert, Pedro Feijão, Marília D. V. Braga, Jens Stoye and Fábio V. Martinez
+   A Linear Time Approximation Algorithm for the DCJ Distance for Genomes with Bounded Number of Duplicates
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdio>
+#include <vector>
+#include <algorithm>
+
+#include "graph.hpp"
+#include "gene-matching.hpp"
+#include "high-copy.hpp"
+
+
+using std::vector;
+
+
+
+/*******************
+ ** AUX FUNCTIONS **
+ *******************/
+// Returns the representative of the set of x (path halving)
+static int findSet(vector<int> &parent, int x)
+{
+  while (parent[x] != x)
+    x = parent[x] = parent[parent[x]];
+  return x;
+}
+
+// Returns the vertex of extremity ex (-1 if none or out of range)
+static inline int vertexOfExtremity(const vector<int> &vertexOf, Extremity ex)
+{
+  int x = ex.index();
+
+  return x >= 0 && x < (int) vertexOf.size() ? vertexOf[x] : -1;
+}
+
+// Returns the number of adjacencies conserved by matching genes a and
+// b: for each side, whether the other extremities of the vertices of
+// a and b are joined by an edge
+static int context(Graph *ag, const vector<int> &vertexOf, int a, int b)
+{
+  const Extremity::Type side[2] = {Extremity::TAIL, Extremity::HEAD};
+  int conserved = 0;
+
+  for (int s = 0; s < 2; s++) {
+    int va = vertexOfExtremity(vertexOf, Extremity(a, side[s])), vb = vertexOfExtremity(vertexOf, Extremity(b, side[s]));
+    if (va < 0 || vb < 0)
+      continue;
+
+    for (auto e : *ag->getVertex(va))
+      if (e->getAdj()->getId() == vb && e->getExtremityFrom().getId() != a && e->getExtremityTo().getId() != b) {
+        conserved++;
+        break;
+      }
+  }
+
+  return conserved;
+}
+
+
+
+/******************************
+ ** HIGHCOPYFALLBACK METHODS **
+ ******************************/
+HighCopyFallback::HighCopyFallback(Graph *ag, int threshold) :
+  threshold(threshold),
+  largest(0),
+  families(0),
+  pairs(0),
+  removed(0)
+{
+  const Extremity::Type side[2] = {Extremity::TAIL, Extremity::HEAD};
+  int genes = 0;
+  double maxW = 0;
+
+  if (ag->getN() == 0)
+    return;
+
+  char part = ag->begin()->getPart();
+
+  for (auto it = ag->begin(); it != ag->end(); ++it)
+    genes = std::max(genes, std::max((*it)->getExtremityLeft().getId(), (*it)->getExtremityRight().getId()) + 1);
+
+  // vertex of each extremity, genome of each gene
+  vector<int> vertexOf(2 * genes, -1), parent(genes);
+  vector<char> inA(genes, 0), present(genes, 0);
+  for (auto it = ag->begin(); it != ag->end(); ++it) {
+    Extremity ex[2] = {(*it)->getExtremityLeft(), (*it)->getExtremityRight()};
+    for (int i = 0; i < 2; i++)
+      if (ex[i].getType() != Extremity::UNDEF) {
+        vertexOf[ex[i].index()] = (*it)->getId();
+        inA[ex[i].getId()] = (*it)->getPart() == part;
+        present[ex[i].getId()] = 1;
+      }
+  }
+
+  // families are the components of the candidate pairs
+  for (int g = 0; g < genes; g++)
+    parent[g] = g;
+  for (auto it = ag->begin(part); it != ag->end(); ++it)
+    for (auto e : **it) {
+      int x = findSet(parent, e->getExtremityFrom().getId()), y = findSet(parent, e->getExtremityTo().getId());
+      if (x != y)
+        parent[x] = y;
+      maxW = std::max(maxW, e->getWeight());
+    }
+
+  vector<int> copiesA(genes, 0), copiesB(genes, 0);
+  for (int g = 0; g < genes; g++)
+    if (present[g])
+      (inA[g] ? copiesA : copiesB)[findSet(parent, g)]++;
+  for (int g = 0; g < genes; g++) {
+    largest = std::max(largest, std::max(copiesA[g], copiesB[g]));
+    if (threshold > 0 && std::max(copiesA[g], copiesB[g]) > threshold)
+      families++;
+  }
+
+  if (threshold <= 0 || families == 0)
+    return;
+
+  // similarity graph of the genes of high-copy families, genome A first
+  Graph sim("high-copy", 16);
+  vector<int> simOf(genes, -1), geneOf;
+  for (int pass = 0; pass < 2; pass++)
+    for (int g = 0; g < genes; g++)
+      if (present[g] && inA[g] == (pass == 0)) {
+        int r = findSet(parent, g);
+        if (std::max(copiesA[r], copiesB[r]) <= threshold)
+          continue;
+        simOf[g] = sim.addVertex((const char *) 0x0, pass == 0 ? 'A' : 'B')->getId();
+        if ((int) geneOf.size() <= simOf[g])
+          geneOf.resize(simOf[g] + 1, 0);
+        geneOf[simOf[g]] = g;
+        affected.push_back(g);
+      }
+
+  if (maxW <= 0)
+    maxW = 1.0;
+  for (auto a : affected) {
+    int va = vertexOfExtremity(vertexOf, Extremity(a, Extremity::TAIL));
+    if (!inA[a] || va < 0)
+      continue;
+
+    for (auto e : *ag->getVertex(va))
+      if (e->getExtremityFrom() == Extremity(a, Extremity::TAIL)) {
+        int b = e->getExtremityTo().getId();
+        Edge *s = sim.addEdge(simOf[a], simOf[b]);
+        s->setWeight(e->getWeight() + context(ag, vertexOf, a, b) * maxW);
+      }
+  }
+
+  GeneMatching matching(&sim);
+  vector<int> mate(genes, 0);
+  for (auto &p : matching.auction()) {
+    mate[geneOf[p.a]] = geneOf[p.b];
+    mate[geneOf[p.b]] = geneOf[p.a];
+    pairs++;
+  }
+
+  // every other edge of the resolved genes goes away
+  vector<Edge *> drop;
+  for (auto g : affected)
+    for (int s = 0; s < 2; s++) {
+      Extremity ex(g, side[s]);
+      int v = vertexOfExtremity(vertexOf, ex);
+      if (v < 0)
+        continue;
+
+      drop.clear();
+      for (auto e : *ag->getVertex(v))
+        if (e->getExtremityFrom() == ex && e->getExtremityTo().getId() != mate[g])
+          drop.push_back(e);
+      for (auto e : drop)
+        ag->removeEdge(e);
+      removed += drop.size();
+    }
+}
+
+void HighCopyFallback::print(void) const
+{
+  if (threshold <= 0)
+    printf("high-copy fallback off, largest family: %d copies\n", largest);
+  else
+    printf("%d genes in %d families with more than %d copies (largest: %d) fixed by heuristic matching: %d pairs, %ld edges removed\n",
+           getGenes(), families, threshold, largest, pairs, removed);
+}
@@ -0,0 +1,97 @@
+/**
+   Copyright (C) 2016 Diego Rubert
+
+   This file is part of the O(k)-approximation algorithm implementation
+   for the DCJ distance on linear unichromosomal genomes in:
+
+   Diego P. Rubert, Pedro Feijão, Marília D. V. Braga, Jens Stoye and Fábio V. Martinez
+   A Linear Time Approximation Algorithm for the DCJ Distance for Genomes with Bounded Number of Duplicates
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+  Fallback for high-copy families. The cost of cycle enumeration grows
+  with the size of the largest family, so families with more than a
+  given number of copies are resolved up front by a fast heuristic and
+  only the others are left to exact enumeration.
+
+  A family is a connected component of the candidate gene pairs (genes
+  joined by some adjacency graph edge) and its number of copies is the
+  largest number of its genes in one genome. In a high-copy family,
+  every candidate pair (a, b) is scored by its positional context: the
+  number of gene extremities next to a and b (in the same adjacency
+  vertex of each genome) that are also joined by an edge, that is, the
+  adjacencies the pair would conserve. Each conserved adjacency counts
+  as much as the heaviest edge, so similarity only breaks ties. A
+  maximum weight matching of the scores (GeneMatching::auction) picks
+  the pairs and every other edge of the family's genes is removed from
+  the adjacency graph, which is changed in place before any engine
+  indexes it. O(n + m + sum of family matchings).
+*/
+
+#ifndef _HIGH_COPY_HPP
+
+#define _HIGH_COPY_HPP 1
+
+#include <vector>
+
+#include "graph.hpp"
+
+
+
+/****************************
+ ** HIGHCOPYFALLBACK CLASS **
+ ****************************/
+class HighCopyFallback {
+private:
+  int threshold;             // Families with more copies are resolved (<= 0 = none)
+  int largest;               // Copies of the largest family
+  int families;              // High-copy families resolved
+  int pairs;                 // Gene pairs fixed
+  long removed;              // Adjacency graph edges removed
+  std::vector<int> affected; // Genes of the resolved families
+
+public:
+  // Resolves in place every family of ag with more than threshold
+  // copies (nothing if threshold <= 0)
+  HighCopyFallback(Graph *ag, int threshold);
+
+  // Returns the copy threshold
+  inline int getThreshold(void) const { return threshold; }
+
+  // Returns the number of copies of the largest family (before resolving)
+  inline int getLargest(void) const { return largest; }
+
+  // Returns the number of high-copy families resolved
+  inline int getFamilies(void) const { return families; }
+
+  // Returns the number of genes (of both genomes) in resolved families
+  inline int getGenes(void) const { return (int) affected.size(); }
+
+  // Returns the ids of the genes in resolved families
+  inline const std::vector<int> &getAffected(void) const { return affected; }
+
+  // Returns the number of gene pairs fixed
+  inline int getPairs(void) const { return pairs; }
+
+  // Returns the number of adjacency graph edges removed
+  inline long getRemoved(void) const { return removed; }
+
+  // Prints a summary
+  void print(void) const;
+};
+
+
+#endif /* high-copy.hpp  */
@@ -0,0 +1,257 @@
+/**
+   Copyright (C) 2016 Diego Rubert
+
+   This file is part of the O(k)-approximation algorithm implementation
+   for the DCJ distance on linear unichromosomal genomes in:
+
+   Diego P. Rubert, Pedro Feijão, Marília D. V. Braga, Jens Stoye and Fábio V. Martinez
+   A Linear Time Approximation Algorithm for the DCJ Distance for Genomes with Bounded Number of Duplicates
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstring>
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <zlib.h>
+
+#include "mapped-file.hpp"
+#include "thread-pool.hpp"
+#include "input-file.hpp"
+
+
+using std::vector;
+
+
+
+/*******************
+ ** AUX FUNCTIONS **
+ *******************/
+// Returns the little endian integer of n bytes at p
+static inline uint32_t little(const unsigned char *p, int n)
+{
+  uint32_t x = 0;
+
+  while (n--)
+    x = (x << 8) | p[n];
+  return x;
+}
+
+// Inflates a raw deflate stream into exactly size bytes, returns false
+// on corrupt data
+static bool inflateRaw(const unsigned char *in, size_t length, char *out, size_t size, uint32_t crc)
+{
+  z_stream z;
+  int ret;
+
+  memset(&z, 0, sizeof(z));
+  if (inflateInit2(&z, -15) != Z_OK)
+    return false;
+
+  z.next_in = (Bytef *) in;
+  z.avail_in = (uInt) length;
+  z.next_out = (Bytef *) out;
+  z.avail_out = (uInt) size;
+  ret = inflate(&z, Z_FINISH);
+  inflateEnd(&z);
+
+  return ret == Z_STREAM_END && z.avail_out == 0 && crc32(0, (const Bytef *) out, (uInt) size) == crc;
+}
+
+
+
+/***********************
+ ** INPUTFILE METHODS **
+ ***********************/
+InputFile::InputFile(void) :
+  format(PLAIN)
+{
+}
+
+bool InputFile::open(const char *path)
+{
+  const unsigned char *p;
+
+  buffer.clear();
+  format = PLAIN;
+  if (!file.open(path))
+    return false;
+
+  p = (const unsigned char *) file.begin();
+  if (file.size() >= 18 && p[0] == 0x1f && p[1] == 0x8b)
+    format = blocks().empty() ? GZIP : BGZF;
+  return true;
+}
+
+vector<size_t> InputFile::blocks(void) const
+{
+  const unsigned char *p = (const unsigned char *) file.begin();
+  size_t n = file.size(), pos = 0;
+  vector<size_t> offset;
+
+  while (pos < n) {
+    size_t size = 0;
+    if (n - pos < 18 || p[pos] != 0x1f || p[pos+1] != 0x8b || p[pos+2] != 8 || !(p[pos+3] & 4))
+      return vector<size_t>();
+
+    // look for the BC subfield (block size - 1) in the extra field
+    size_t xlen = little(p + pos + 10, 2), x = pos + 12, xend = x + xlen;
+    if (xend > n)
+      return vector<size_t>();
+    for (; x + 4 <= xend; x += 4 + little(p + x + 2, 2))
+      if (p[x] == 'B' && p[x+1] == 'C' && little(p + x + 2, 2) == 2 && x + 6 <= xend)
+        size = little(p + x + 4, 2) + 1;
+
+    if (size < 12 + xlen + 8 || pos + size > n)
+      return vector<size_t>();
+    offset.push_back(pos);
+    pos += size;
+  }
+
+  offset.push_back(n);
+  return offset;
+}
+
+bool InputFile::inflateBlocks(const vector<size_t> &offset, size_t from, size_t to, ThreadPool *pool)
+{
+  const unsigned char *p = (const unsigned char *) file.begin();
+  vector<size_t> out(to - from + 1, buffer.size());
+  std::atomic<bool> ok(true);
+
+  // every block's place in buffer, from the sizes in the trailers
+  for (size_t k = from; k < to; k++)
+    out[k-from+1] = out[k-from] + little(p + offset[k+1] - 4, 4);
+  buffer.resize(out.back());
+
+  auto body = [&](long first, long last, long) {
+    for (long k = first; k < last && ok; k++) {
+      // empty blocks (the EOF marker) may have nowhere to go: buffer.data() is NULL
+      if (out[k-from+1] == out[k-from])
+        continue;
+      size_t pos = offset[k], end = offset[k+1], xlen = little(p + pos + 10, 2);
+      if (!inflateRaw(p + pos + 12 + xlen, end - 8 - (pos + 12 + xlen), buffer.data() + out[k-from],
+                      out[k-from+1] - out[k-from], little(p + end - 8, 4)))
+        ok = false;
+    }
+  };
+  if (pool)
+    pool->parallelFor(from, to, body);
+  else
+    body(from, to, 0);
+
+  return ok;
+}
+
+bool InputFile::decompress(const std::function<void(const char *, const char *)> *consumer, ThreadPool *pool, size_t chunkSize)
+{
+  // feeds the consumer up to the last newline of buffer (everything if last)
+  auto emit = [&](bool last) {
+    if (consumer == NULL || buffer.empty())
+      return;
+    const char *b = buffer.data(), *nl = last ? b + buffer.size() - 1 : (const char *) memrchr(b, '\n', buffer.size());
+    if (nl == NULL)
+      return;
+    (*consumer)(b, nl + 1);
+    buffer.erase(buffer.begin(), buffer.begin() + (nl + 1 - b));
+  };
+
+  buffer.clear();
+  if (format == BGZF) {
+    vector<size_t> offset = blocks();
+    for (size_t k = 0, j; k + 1 < offset.size(); k = j) {
+      for (j = k + 1; j + 1 < offset.size() && offset[j] - offset[k] < chunkSize; j++)
+        ;
+      if (!inflateBlocks(offset, k, j, pool))
+        return false;
+      emit(j + 1 == offset.size());
+    }
+    return true;
+  }
+
+  // plain gzip, one member after the other, into an output growing
+  // geometrically (by its own size, from 64 KB)
+  const unsigned char *p = (const unsigned char *) file.begin();
+  size_t n = file.size(), pos = 0, used = 0, most = (size_t) 1 << 30;
+  z_stream z;
+  int ret = Z_OK;
+
+  memset(&z, 0, sizeof(z));
+  if (inflateInit2(&z, 15 + 16) != Z_OK)
+    return false;
+
+  while (pos < n) {
+    if (used == buffer.size())
+      buffer.resize(used + std::min(std::max(used, (size_t) 65536), most));
+    z.next_in = (Bytef *) p + pos;
+    z.avail_in = (uInt) std::min(n - pos, most);
+    z.next_out = (Bytef *) buffer.data() + used;
+    z.avail_out = (uInt) std::min(buffer.size() - used, most);
+    size_t before = z.avail_in, room = z.avail_out;
+    ret = inflate(&z, Z_NO_FLUSH);
+    pos += before - z.avail_in;
+    used += room - z.avail_out;
+
+    if (ret == Z_STREAM_END) { // another member may follow (but not padding)
+      if (pos + 2 > n || p[pos] != 0x1f || p[pos+1] != 0x8b)
+        break;
+      inflateReset(&z);
+    }
+    else if (ret != Z_OK && ret != Z_BUF_ERROR)
+      break;
+    else if (ret == Z_BUF_ERROR && before == z.avail_in && z.avail_out == room)
+      break; // no progress: truncated input
+
+    if (consumer && used >= chunkSize) {
+      buffer.resize(used);
+      emit(false);
+      used = buffer.size();
+    }
+  }
+  buffer.resize(used);
+  inflateEnd(&z);
+
+  if (ret != Z_STREAM_END)
+    return false;
+  emit(true);
+  return true;
+}
+
+bool InputFile::read(const char *&begin, const char *&end, ThreadPool *pool)
+{
+  if (format == PLAIN) {
+    begin = file.begin();
+    end = file.end();
+    return true;
+  }
+
+  if (!decompress(NULL, pool, (size_t) -1))
+    return false;
+  begin = buffer.data();
+  end = buffer.data() + buffer.size();
+  return true;
+}
+
+bool InputFile::read(const std::function<void(const char *, const char *)> &consumer, ThreadPool *pool, size_t chunkSize)
+{
+  if (format == PLAIN) {
+    if (file.size() > 0)
+      consumer(file.begin(), file.end());
+    return true;
+  }
+
+  return decompress(&consumer, pool, chunkSize);
+}
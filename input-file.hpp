@@ -0,0 +1,101 @@
+/**
+   Copyright (C) 2016 Diego Rubert
+
+   This file is part of the O(k)-approximation algorithm implementation
+   for the DCJ distance on linear unichromosomal genomes in:
+
+   Diego P. Rubert, Pedro Feijão, Marília D. V. Braga, Jens Stoye and Fábio V. Martinez
+   A Linear Time Approximation Algorithm for the DCJ Distance for Genomes with Bounded Number of Duplicates
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+  Transparent input of plain, gzip and BGZF compressed files (zlib,
+  link with -lz). Plain files are memory mapped and never copied. BGZF
+  files (gzip members of at most 64 KB, each one recording its
+  compressed size in a 'BC' extra field and its uncompressed size in
+  its trailer) are decompressed a batch of blocks at a time, every
+  block of the batch inflated on a thread pool straight into its place
+  in the output. Other gzip files (possibly of many members) are
+  inflated by a single thread.
+
+  Content is either read whole (parsers that keep state across lines,
+  like GenomeParser) or fed to a consumer in pieces that end right
+  after a newline (line oriented parsers, like BlastParser), so large
+  compressed files never need to fit in memory.
+*/
+
+#ifndef _INPUT_FILE_HPP
+
+#define _INPUT_FILE_HPP 1
+
+#include <cstddef>
+#include <vector>
+#include <functional>
+
+#include "mapped-file.hpp"
+#include "thread-pool.hpp"
+
+
+
+/*********************
+ ** INPUTFILE CLASS **
+ *********************/
+class InputFile {
+public:
+  // Formats recognized
+  enum Format {PLAIN, GZIP, BGZF};
+
+private:
+  MappedFile file;          // Raw file
+  Format format;            // Format of the file
+  std::vector<char> buffer; // Decompressed content (whole, or the current piece)
+
+  // Inflates the BGZF blocks at [from, to) of the file in parallel,
+  // appending them to buffer, returns false on corrupt data
+  bool inflateBlocks(const std::vector<size_t> &offset, size_t from, size_t to, ThreadPool *pool);
+
+  // Offsets of the BGZF blocks of the file (plus its size), empty if
+  // the file is not entirely made of BGZF blocks
+  std::vector<size_t> blocks(void) const;
+
+  // Decompresses the file about chunkSize input bytes at a time, each
+  // time feeding consumer with the buffer up to its last newline (or
+  // keeping everything in buffer if consumer is NULL)
+  bool decompress(const std::function<void(const char *, const char *)> *consumer, ThreadPool *pool, size_t chunkSize);
+
+public:
+  // Creates a closed input
+  InputFile(void);
+
+  // Opens and identifies the file at path, returns false on error
+  bool open(const char *path);
+
+  // Returns the format of the file
+  inline Format getFormat(void) const { return format; }
+
+  // Reads the whole content into [begin, end) (valid until the next
+  // read or open), returns false on corrupt data
+  bool read(const char *&begin, const char *&end, ThreadPool *pool = NULL);
+
+  // Feeds the content to consumer in pieces ending right after a
+  // newline (but the last) of about chunkSize bytes (compressed, for
+  // BGZF), returns false on corrupt data
+  bool read(const std::function<void(const char *, const char *)> &consumer,
+            ThreadPool *pool = NULL, size_t chunkSize = 64 << 20);
+};
+
+
+#endif /* input-file.hpp  */
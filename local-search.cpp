@@ -0,0 +1,297 @@
+/**
+   Copyright (C) 2016 Diego Rubert
+
+   This file is part of the O(k)-approximation algorithm implementation
+   for the DCJ distance on linear unichromosomal genomes in:
+
+   Diego P. Rubert, Pedro Feijão, Marília D. V. Braga, Jens Stoye and Fábio V. Martinez
+   A Linear Time Approximation Algorithm for the DCJ Distance for Genomes with Bounded Number of Duplicates
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdio>
+#include <vector>
+#include <string>
+#include <random>
+#include <mutex>
+#include <chrono>
+#include <fstream>
+
+#include "graph.hpp"
+#include "conflict-graph.hpp"
+#include "delta-scoring.hpp"
+#include "bounds.hpp"
+#include "solvers.hpp"
+#include "warm-start.hpp"
+#include "local-search.hpp"
+
+
+using std::vector;
+using std::string;
+
+
+
+/*************************
+ ** LOCALSEARCH METHODS **
+ *************************/
+LocalSearch::LocalSearch(Graph *ag, const ConflictGraph *g, unsigned seed) :
+  g(g),
+  scorer(ag, g),
+  bound(g),
+  rng(seed),
+  iteration(0),
+  current(0),
+  started(false),
+  bestValue(0),
+  polledIteration(0),
+  running(false),
+  ranFor(0),
+  stopRequested(false),
+  checkpointInterval(60)
+{}
+
+void LocalSearch::init(const vector<int> &solution)
+{
+  for (auto c : scorer.solution())
+    scorer.remove(c);
+
+  current = 0;
+  for (auto c : solution) {
+    scorer.insert(c);
+    current += g->weight(c);
+  }
+  started = true;
+
+  std::lock_guard<std::mutex> guard(lock);
+  best = solution;
+  bestValue = current;
+}
+
+void LocalSearch::apply(int c)
+{
+  vector<int> evicted, blocking;
+
+  scorer.insert(c, &evicted);
+  current += g->weight(c);
+  for (auto x : evicted)
+    current -= g->weight(x);
+
+  // neighbors of evicted cycles may have become free
+  for (auto x : evicted)
+    for (const int *u = g->begin(x); u != g->end(x); u++) {
+      if (scorer.isPacked(*u))
+        continue;
+      blocking.clear();
+      scorer.blockers(*u, blocking);
+      if (blocking.empty()) {
+        scorer.insert(*u);
+        current += g->weight(*u);
+      }
+    }
+}
+
+void LocalSearch::snapshot(void)
+{
+  std::lock_guard<std::mutex> guard(lock);
+  polledIteration = iteration;
+  if (current > bestValue + 1e-9) {
+    best = scorer.solution();
+    bestValue = current;
+  }
+}
+
+double LocalSearch::elapsed(void) const
+{
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int LocalSearch::init(const EdgeSets &sets)
+{
+  int unmapped;
+  init(warmStart(g, sets, &unmapped));
+  return unmapped;
+}
+
+void LocalSearch::setCheckpoint(const char *path, double interval)
+{
+  checkpointPath = path ? path : "";
+  checkpointInterval = interval;
+}
+
+bool LocalSearch::writeCheckpoint(const char *path)
+{
+  string tmp = string(path) + ".tmp";
+  vector<int> solution = scorer.solution(), bestCopy = getBest();
+  std::ofstream out(tmp.c_str());
+
+  if (!out)
+    return false;
+
+  out << "ffdcj-checkpoint 1\n";
+  out << "graph " << g->getN() << ' ' << g->getM() << '\n';
+  out << "iteration " << iteration << '\n';
+  out << "rng " << rng << '\n';
+  out << "current " << solution.size();
+  for (auto c : solution)
+    out << ' ' << c;
+  out << "\nbest " << bestCopy.size();
+  for (auto c : bestCopy)
+    out << ' ' << c;
+  out << '\n';
+  out.close();
+
+  if (!out)
+    return false;
+  return std::rename(tmp.c_str(), path) == 0; // so a crash never leaves a partial checkpoint
+}
+
+bool LocalSearch::resume(const char *path)
+{
+  std::ifstream in(path);
+  string word;
+  int version, n, size;
+  long m, it;
+  std::mt19937 state;
+  vector<int> solution, bestSolution;
+
+  if (!(in >> word >> version) || word != "ffdcj-checkpoint" || version != 1)
+    return false;
+  if (!(in >> word >> n >> m) || word != "graph" || n != g->getN() || m != g->getM())
+    return false; // written for another conflict graph
+  if (!(in >> word >> it) || word != "iteration")
+    return false;
+  if (!(in >> word >> state) || word != "rng")
+    return false;
+
+  for (auto target : {&solution, &bestSolution}) {
+    if (!(in >> word >> size) || (word != "current" && word != "best") || size < 0 || size > n)
+      return false;
+    target->resize(size);
+    for (auto &c : *target)
+      if (!(in >> c) || c < 0 || c >= n)
+        return false;
+  }
+  if (!g->independent(solution) || !g->independent(bestSolution))
+    return false;
+
+  init(solution);
+  rng = state;
+  iteration = it;
+
+  std::lock_guard<std::mutex> guard(lock);
+  polledIteration = iteration;
+  best = bestSolution;
+  bestValue = g->weight(bestSolution);
+  return true;
+}
+
+void LocalSearch::run(double seconds, long iterations)
+{
+  int n = g->getN();
+  long limit = iterations >= 0 ? iteration + iterations : -1;
+  long stagnation = 0;
+  double lastCheckpoint = 0;
+  vector<int> blocking;
+
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    running = true;
+    start = std::chrono::steady_clock::now();
+  }
+  stopRequested = false;
+
+  if (!started)
+    init(greedyPacking(g));
+
+  while (n > 0) {
+    if (limit >= 0 && iteration >= limit)
+      break;
+    if ((iteration & 255) == 0) { // other checks are not for free
+      snapshot();
+      if (stopRequested || elapsed() >= seconds || bound.closed(getBestValue()))
+        break;
+      if (!checkpointPath.empty() && elapsed() - lastCheckpoint >= checkpointInterval) {
+        writeCheckpoint(checkpointPath.c_str());
+        lastCheckpoint = elapsed();
+      }
+    }
+    iteration++;
+
+    int c = rng() % n;
+    if (scorer.isPacked(c))
+      continue;
+
+    double delta = g->weight(c);
+    blocking.clear();
+    scorer.blockers(c, blocking);
+    for (auto x : blocking)
+      delta -= g->weight(x);
+
+    if (delta > 1e-9) {                         // improving
+      apply(c);
+      stagnation = 0;
+    }
+    else if (delta > -1e-9 && rng() % 2) {      // plateau
+      apply(c);
+      stagnation++;
+    }
+    else if (++stagnation > n) {                // stuck for long: perturb
+      apply(c);
+      stagnation = 0;
+    }
+
+    if (current > bestValue + 1e-9)
+      snapshot();
+  }
+
+  snapshot();
+  if (!checkpointPath.empty())
+    writeCheckpoint(checkpointPath.c_str());
+
+  std::lock_guard<std::mutex> guard(lock);
+  ranFor = elapsed();
+  running = false;
+}
+
+void LocalSearch::stop(void)
+{
+  stopRequested = true;
+}
+
+SolverProgress LocalSearch::poll(void) const
+{
+  std::lock_guard<std::mutex> guard(lock);
+  SolverProgress p;
+
+  p.iteration = polledIteration;
+  p.best = bestValue;
+  p.bound = bound.best();
+  p.gap = bound.gap(bestValue);
+  p.elapsed = running ? elapsed() : ranFor;
+  p.running = running;
+  return p;
+}
+
+vector<int> LocalSearch::getBest(void) const
+{
+  std::lock_guard<std::mutex> guard(lock);
+  return best;
+}
+
+double LocalSearch::getBestValue(void) const
+{
+  std::lock_guard<std::mutex> guard(lock);
+  return bestValue;
+}
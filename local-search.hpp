@@ -0,0 +1,153 @@
+/**
+   Copyright (C) 2016 Diego Rubert
+
+   This file is part of the O(k)-approximation algorithm implementation
+   for the DCJ distance on linear unichromosomal genomes in:
+
+   Diego P. Rubert, Pedro Feijão, Marília D. V. Braga, Jens Stoye and Fábio V. Martinez
+   A Linear Time Approximation Algorithm for the DCJ Distance for Genomes with Bounded Number of Duplicates
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+  Anytime local search for cycle packing (independent set on the
+  conflict graph, maximizing the sum of ConflictGraph weights). Each
+  iteration tries to insert a random cycle, evicting its blockers
+  (found by the DeltaScorer), and accepts improving moves, plateau
+  moves with probability 1/2 and, after a while without improvement,
+  worsening ones to escape local optima. Every eviction is followed by
+  a refill of the neighbors of evicted cycles that became free, which
+  gives the (1,2)-swaps.
+
+  The search runs until a deadline, an iteration limit, a stop request
+  or until the best solution reaches the upper bound (PackingBound).
+  Other threads may poll its progress and best solution at any time.
+  It can also periodically write a checkpoint with the current and
+  best solutions (frozen cycle ids), the RNG state and the iteration,
+  so that a later run on the same CyclesGraph resumes from there in
+  time proportional to the checkpoint size.
+*/
+
+#ifndef _LOCAL_SEARCH_HPP
+
+#define _LOCAL_SEARCH_HPP 1
+
+#include <vector>
+#include <string>
+#include <random>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+
+#include "graph.hpp"
+#include "conflict-graph.hpp"
+#include "delta-scoring.hpp"
+#include "bounds.hpp"
+#include "warm-start.hpp"
+
+
+
+/**************************
+ ** SOLVERPROGRESS CLASS **
+ **************************/
+// Snapshot of a running solver
+struct SolverProgress {
+  long iteration;  // Iterations done
+  double best;     // Value of the best solution
+  double bound;    // Upper bound on the optimum
+  double gap;      // Relative gap between both
+  double elapsed;  // Seconds running
+  bool running;    // Whether run() is still going
+};
+
+
+/***********************
+ ** LOCALSEARCH CLASS **
+ ***********************/
+class LocalSearch {
+private:
+  const ConflictGraph *g;           // Conflict graph
+  DeltaScorer scorer;               // Current solution
+  PackingBound bound;               // Upper bounds on the optimum
+  std::mt19937 rng;                 // Random number generator (saved in checkpoints)
+  long iteration;                   // Iterations done (saved in checkpoints)
+  double current;                   // Value of current solution
+  bool started;                     // Whether the current solution was initialized
+
+  mutable std::mutex lock;          // Guards everything below
+  std::vector<int> best;            // Best solution found
+  double bestValue;                 // Its value
+  long polledIteration;             // Iteration at last snapshot
+  bool running;                     // Whether run() is going
+  std::chrono::steady_clock::time_point start; // When run() started
+  double ranFor;                    // Seconds the last run() took
+  std::atomic<bool> stopRequested;  // Set by stop()
+
+  std::string checkpointPath;       // Where to write checkpoints ("" = never)
+  double checkpointInterval;        // Seconds between checkpoints
+
+  // Inserts c (evicting blockers) and refills around evicted cycles
+  void apply(int c);
+
+  // Copies the current solution to best, if better
+  void snapshot(void);
+
+  // Elapsed seconds since run() started
+  double elapsed(void) const;
+
+public:
+  // Receives the adjacency graph the CyclesGraph frozen in g was built
+  // from (or NULL, see DeltaScorer) and the RNG seed
+  LocalSearch(Graph *ag, const ConflictGraph *g, unsigned seed = 1);
+
+  // Starts from a given solution (independent set of g), replacing the current one
+  void init(const std::vector<int> &solution);
+
+  // Starts from a previous packing (see warmStart()), returns the
+  // number of its cycles missing in g
+  int init(const EdgeSets &sets);
+
+  // Writes a checkpoint to path every interval seconds while running
+  void setCheckpoint(const char *path, double interval = 60);
+
+  // Writes a checkpoint now, returns false on I/O error
+  bool writeCheckpoint(const char *path);
+
+  // Resumes from a checkpoint written for the same conflict graph,
+  // returns false (changing nothing) if it can't be read or doesn't match
+  bool resume(const char *path);
+
+  // Runs for at most seconds and iterations (< 0 = no limit), starting
+  // from the greedy solution if no other was given
+  void run(double seconds, long iterations = -1);
+
+  // Asks run() to return as soon as possible (thread safe)
+  void stop(void);
+
+  // Returns a snapshot of the progress (thread safe)
+  SolverProgress poll(void) const;
+
+  // Returns the best solution found so far (thread safe)
+  std::vector<int> getBest(void) const;
+
+  // Returns the value of the best solution (thread safe)
+  double getBestValue(void) const;
+
+  // Returns the bounds
+  inline const PackingBound &getBound(void) const { return bound; }
+};
+
+
+#endif /* local-search.hpp  */
@@ -0,0 +1,87 @@
+/**
+   Copyright (C) 2016 Diego Rubert
+
+   This file is part of the O(k)-approximation algorithm implementation
+   for the DCJ distance on linear unichromosomal genomes in:
+
+   Diego P. Rubert, Pedro Feijão, Marília D. V. Braga, Jens Stoye and Fábio V. Martinez
+   A Linear Time Approximation Algorithm for the DCJ Distance for Genomes with Bounded Number of Duplicates
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "mapped-file.hpp"
+
+
+
+/************************
+ ** MAPPEDFILE METHODS **
+ ************************/
+MappedFile::MappedFile(void) :
+  data(NULL),
+  length(0)
+{
+}
+
+MappedFile::~MappedFile()
+{
+  close();
+}
+
+bool MappedFile::open(const char *path)
+{
+  struct stat st;
+  int fd, err;
+
+  close();
+  if ((fd = ::open(path, O_RDONLY)) < 0)
+    return false;
+
+  if (fstat(fd, &st) < 0) {
+    err = errno;
+    ::close(fd);
+    errno = err;
+    return false;
+  }
+
+  if (st.st_size > 0) { // empty files can't be mapped, but they are valid
+    void *p = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (p == MAP_FAILED) {
+      err = errno;
+      ::close(fd);
+      errno = err;
+      return false;
+    }
+    madvise(p, st.st_size, MADV_SEQUENTIAL);
+    data = (const char *) p;
+    length = st.st_size;
+  }
+
+  ::close(fd); // the mapping keeps the file
+  return true;
+}
+
+void MappedFile::close(void)
+{
+  if (data)
+    munmap((void *) data, length);
+  data = NULL;
+  length = 0;
+}
@@ -0,0 +1,73 @@
+/**
+   Copyright (C) 2016 Diego Rubert
+
+   This file is part of the O(k)-approximation algorithm implementation
+   for the DCJ distance on linear unichromosomal genomes in:
+
+   Diego P. Rubert, Pedro Feijão, Marília D. V. Braga, Jens Stoye and Fábio V. Martinez
+   A Linear Time Approximation Algorithm for the DCJ Distance for Genomes with Bounded Number of Duplicates
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+  Read-only memory mapping of a whole file, so parsers can tokenize it
+  in place without copying it into buffers. The mapping is advised as
+  sequential and released when the object is closed or destroyed.
+*/
+
+#ifndef _MAPPED_FILE_HPP
+
+#define _MAPPED_FILE_HPP 1
+
+#include <cstddef>
+
+
+
+/**********************
+ ** MAPPEDFILE CLASS **
+ **********************/
+class MappedFile {
+private:
+  const char *data; // First byte of the mapping (NULL if closed or empty)
+  size_t length;    // Size of the file
+
+public:
+  // Creates a closed mapping
+  MappedFile(void);
+
+  // Unmaps the file
+  ~MappedFile();
+
+  // Not copyable (owns the mapping)
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  // Maps the file at path (closing any previous one), returns false on
+  // error (errno is kept)
+  bool open(const char *path);
+
+  // Unmaps the file
+  void close(void);
+
+  // Returns the first byte and the one past the last
+  inline const char *begin(void) const { return data; }
+  inline const char *end(void) const { return data + length; }
+
+  // Returns the size of the file
+  inline size_t size(void) const { return length; }
+};
+
+
+#endif /* mapped-file.hpp  */
@@ -0,0 +1,175 @@
+/**
+   Copyright (C) 2016 Diego Rubert
+
+   This file is part of the O(k)-approximation algorithm implementation
+   for the DCJ distance on linear unichromosomal genomes in:
+
+   Diego P. Rubert, Pedro Feijão, Marília D. V. Braga, Jens Stoye and Fábio V. Martinez
+   A Linear Time Approximation Algorithm for the DCJ Distance for Genomes with Bounded Number of Duplicates
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <chrono>
+
+#include "graph.hpp"
+#include "conflict-graph.hpp"
+#include "bounds.hpp"
+#include "solvers.hpp"
+#include "local-search.hpp"
+#include "multilevel.hpp"
+
+
+using std::vector;
+
+
+
+/******************************
+ ** MULTILEVELSOLVER METHODS **
+ ******************************/
+MultilevelSolver::MultilevelSolver(Graph *ag, const ConflictGraph *g, unsigned seed, int coarsest) :
+  ag(ag),
+  seed(seed)
+{
+  vector<int> group;
+
+  levels.push_back(g);
+  while (levels.back()->getN() > coarsest) {
+    const ConflictGraph *fine = levels.back();
+    int n = fine->getN(), groups;
+
+    if (levels.size() == 1 && fine->hasCycles()) { // hyperedge groups
+      bucketCoverBound(fine, group);
+      groups = 1 + *std::max_element(group.begin(), group.end());
+    }
+    else
+      groups = matching(fine, group, seed + levels.size());
+
+    if (groups > n - n / 20) // less than 5% smaller, not worth it
+      break;
+    contract((int) levels.size() - 1, group, groups);
+  }
+}
+
+MultilevelSolver::~MultilevelSolver()
+{
+  for (size_t l = 1; l < levels.size(); l++)
+    delete levels[l];
+}
+
+int MultilevelSolver::matching(const ConflictGraph *g, vector<int> &group, unsigned seed) const
+{
+  int n = g->getN(), groups = 0;
+  vector<int> order(n);
+  std::mt19937 rng(seed);
+
+  for (int v = 0; v < n; v++)
+    order[v] = v;
+  std::shuffle(order.begin(), order.end(), rng);
+
+  group.assign(n, -1);
+  for (auto v : order) {
+    if (group[v] >= 0)
+      continue;
+    int mate = -1;
+    for (const int *u = g->begin(v); u != g->end(v); u++)
+      if (group[*u] < 0 && (mate < 0 || g->degree(*u) < g->degree(mate)))
+        mate = *u;
+    group[v] = groups;
+    if (mate >= 0)
+      group[mate] = groups;
+    groups++;
+  }
+
+  return groups;
+}
+
+void MultilevelSolver::contract(int l, const vector<int> &group, int groups)
+{
+  const ConflictGraph *g = levels[l];
+  int n = g->getN();
+  vector<int> first(groups + 1, 0), members(n), mark(groups, -1);
+  vector<int> off(groups + 1, 0), adj;
+  vector<double> w(groups, 0);
+
+  // members of each group (counting sort)
+  for (int v = 0; v < n; v++)
+    first[group[v] + 1]++;
+  for (int x = 0; x < groups; x++)
+    first[x+1] += first[x];
+  vector<int> pos(first.begin(), first.end() - 1);
+  for (int v = 0; v < n; v++)
+    members[pos[group[v]]++] = v;
+
+  rep.push_back(vector<int>(groups, -1));
+  vector<int> &heaviest = rep.back();
+  for (int x = 0; x < groups; x++) {
+    for (int i = first[x]; i < first[x+1]; i++) {
+      int v = members[i];
+      if (heaviest[x] < 0 || g->weight(v) > g->weight(heaviest[x]))
+        heaviest[x] = v;
+      for (const int *u = g->begin(v); u != g->end(v); u++) {
+        int y = group[*u];
+        if (y != x && mark[y] != x) {
+          mark[y] = x;
+          adj.push_back(y);
+        }
+      }
+    }
+    w[x] = g->weight(heaviest[x]);
+    off[x+1] = (int) adj.size();
+  }
+
+  coarse.push_back(group);
+  levels.push_back(new ConflictGraph(off, adj, w));
+}
+
+vector<int> MultilevelSolver::run(double seconds, int passes, const vector<int> *initial)
+{
+  auto start = std::chrono::steady_clock::now();
+  double total = 0, done = 0;
+  vector<int> solution = greedyPacking(levels.back());
+
+  for (auto g : levels)
+    total += g->getN();
+
+  for (int l = (int) levels.size() - 1; l >= 0; l--) {
+    int n = levels[l]->getN();
+
+    if (l + 1 < (int) levels.size()) { // project from level l+1
+      vector<int> projected;
+      for (auto x : solution)
+        projected.push_back(rep[l][x]);
+      solution.swap(projected);
+      completePacking(levels[l], solution);
+    }
+    if (l == 0 && initial && levels[0]->weight(*initial) >= levels[0]->weight(solution))
+      solution = *initial;
+
+    // this level's share of the remaining time
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    double budget = n > 0 ? std::max(0.0, seconds - elapsed) * n / (total - done) : 0;
+    done += n;
+
+    LocalSearch search(l == 0 ? ag : NULL, levels[l], seed + l);
+    search.init(solution);
+    search.run(budget, (long) passes * n);
+    solution = search.getBest();
+  }
+
+  return solution;
+}
@@ -0,0 +1,102 @@
+/**
+   Copyright (C) 2016 Diego Rubert
+
+   This file is part of the O(k)-approximation algorithm implementation
+   for the DCJ distance on linear unichromosomal genomes in:
+
+   Diego P. Rubert, Pedro Feijão, Marília D. V. Braga, Jens Stoye and Fábio V. Martinez
+   A Linear Time Approximation Algorithm for the DCJ Distance for Genomes with Bounded Number of Duplicates
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+  Multilevel heuristic for the maximum weight independent set in large
+  conflict graphs. The graph is coarsened level by level contracting
+  groups of pairwise adjacent vertices: at the first level the cliques
+  of the gene extremity bucket cover (hyperedge groups, cycles sharing
+  a gene extremity), at further levels a matching of adjacent vertices.
+  A coarse vertex weighs as its heaviest member and is adjacent to the
+  union of its members' neighbors, so an independent set of a coarse
+  level becomes one of the finer level by taking the heaviest member
+  of each chosen vertex (members of different non-adjacent coarse
+  vertices are never adjacent).
+
+  The coarsest level is solved by greedy plus local search, then the
+  solution is projected back level by level, completed to a maximal
+  one and refined by local search, with time split among levels
+  proportionally to their sizes.
+*/
+
+#ifndef _MULTILEVEL_HPP
+
+#define _MULTILEVEL_HPP 1
+
+#include <vector>
+
+#include "graph.hpp"
+#include "conflict-graph.hpp"
+
+
+
+/****************************
+ ** MULTILEVELSOLVER CLASS **
+ ****************************/
+class MultilevelSolver {
+private:
+  Graph *ag;                                 // Adjacency graph of the first level (may be NULL)
+  std::vector<const ConflictGraph *> levels; // Coarser and coarser graphs, levels[0] is the given one (not owned)
+  std::vector<std::vector<int>> coarse;      // coarse[l][v] = vertex of level l+1 containing vertex v of level l
+  std::vector<std::vector<int>> rep;         // rep[l][x] = heaviest vertex of level l contracted into x of level l+1
+  unsigned seed;                             // RNG seed
+
+  // Groups vertices of g by a matching of adjacent vertices (each
+  // unmatched vertex, in random order, with its unmatched neighbor of
+  // smallest degree), fills group and returns the number of groups
+  int matching(const ConflictGraph *g, std::vector<int> &group, unsigned seed) const;
+
+  // Adds to level l the coarse graph with the given vertex groups
+  void contract(int l, const std::vector<int> &group, int groups);
+
+public:
+  // Builds the hierarchy for g (frozen from the CyclesGraph built from
+  // ag, which may be NULL, see DeltaScorer) until a level has at most
+  // coarsest vertices or contracting stops shrinking the graph
+  MultilevelSolver(Graph *ag, const ConflictGraph *g, unsigned seed = 1, int coarsest = 1000);
+
+  ~MultilevelSolver();
+
+  MultilevelSolver(const MultilevelSolver &) = delete;
+  MultilevelSolver &operator=(const MultilevelSolver &) = delete;
+
+  // Returns the number of levels (the given graph included)
+  inline int getLevels(void) const { return (int) levels.size(); }
+
+  // Returns the graph of level l (0 is the given one)
+  inline const ConflictGraph *getLevel(int l) const { return levels[l]; }
+
+  // Returns the vertex of level l+1 that vertex v of level l was contracted into
+  inline int coarseVertex(int l, int v) const { return coarse[l][v]; }
+
+  // Solves the coarsest level and refines the solution at each level
+  // for passes * (level size) local search iterations at most, all in
+  // at most about seconds. If initial (an independent set of the given
+  // graph, e.g. a warm start) is given and is at least as heavy as the
+  // projected solution, the last refinement starts from it instead.
+  // Returns an independent set of the given graph
+  std::vector<int> run(double seconds, int passes = 20, const std::vector<int> *initial = NULL);
+};
+
+
+#endif /* multilevel.hpp  */
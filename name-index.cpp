@@ -0,0 +1,105 @@
+/**
+   Copyright (C) 2016 Diego Rubert
+
+   This file is part of the O(k)-approximation algorithm implementation
+   for the DCJ distance on linear unichromosomal genomes in:
+
+   Diego P. Rubert, Pedro Feijão, Marília D. V. Braga, Jens Stoye and Fábio V. Martinez
+   A Linear Time Approximation Algorithm for the DCJ Distance for Genomes with Bounded Number of Duplicates
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstring>
+#include <vector>
+
+#include "name-index.hpp"
+
+
+using std::vector;
+
+
+
+/***********************
+ ** NAMEINDEX METHODS **
+ ***********************/
+NameIndex::NameIndex(size_t expected)
+{
+  size_t n = 16;
+
+  while (n < 2 * expected)
+    n *= 2;
+  table.assign(n, Slot{0, 0, 0, -1});
+  mask = n - 1;
+}
+
+size_t NameIndex::slot(const char *s, size_t len, uint64_t h) const
+{
+  size_t i = h & mask;
+
+  while (table[i].id >= 0) {
+    const Slot &x = table[i];
+    if (x.hash == h && x.length == len && memcmp(&arena[x.offset], s, len) == 0)
+      break;
+    i = (i + 1) & mask;
+  }
+
+  return i;
+}
+
+void NameIndex::grow(void)
+{
+  vector<Slot> old(2 * table.size(), Slot{0, 0, 0, -1});
+
+  old.swap(table);
+  mask = table.size() - 1;
+  for (auto &x : old)
+    if (x.id >= 0) {
+      size_t i = x.hash & mask;
+      while (table[i].id >= 0)
+        i = (i + 1) & mask;
+      table[i] = x;
+    }
+}
+
+int NameIndex::insert(const char *s, size_t len)
+{
+  uint64_t h = hash(s, len);
+  size_t i = slot(s, len, h);
+
+  if (table[i].id >= 0)
+    return table[i].id;
+
+  int id = size();
+  table[i] = Slot{h, arena.size(), (uint32_t) len, id};
+  offset.push_back(arena.size());
+  arena.insert(arena.end(), s, s + len);
+  arena.push_back('\0');
+
+  if (2 * offset.size() > table.size())
+    grow();
+  return id;
+}
+
+int NameIndex::find(const char *s, size_t len) const
+{
+  return table[slot(s, len, hash(s, len))].id;
+}
+
+void NameIndex::clear(void)
+{
+  arena.clear();
+  offset.clear();
+  table.assign(table.size(), Slot{0, 0, 0, -1});
+}
@@ -0,0 +1,100 @@
+/**
+   Copyright (C) 2016 Diego Rubert
+
+   This file is part of the O(k)-approximation algorithm implementation
+   for the DCJ distance on linear unichromosomal genomes in:
+
+   Diego P. Rubert, Pedro Feijão, Marília D. V. Braga, Jens Stoye and Fábio V. Martinez
+   A Linear Time Approximation Algorithm for the DCJ Distance for Genomes with Bounded Number of Duplicates
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+  Dense ids for names (genes, families) read by the parsers. Names are
+  given as (pointer, length) ranges, e.g. straight from a mapped file,
+  and are only copied (to a single NUL-separated arena) the first time
+  they are seen, so resolving a name never allocates. The table is open
+  addressing with linear probing on a 64-bit FNV-1a hash, kept at most
+  half full. Slots hold the hash, length and arena offset of their
+  name, so a lookup touches one slot and, on a hash match, the arena.
+*/
+
+#ifndef _NAME_INDEX_HPP
+
+#define _NAME_INDEX_HPP 1
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+
+
+/*********************
+ ** NAMEINDEX CLASS **
+ *********************/
+class NameIndex {
+private:
+  // A name in the table
+  struct Slot {
+    uint64_t hash;   // Hash of the name
+    size_t offset;   // Start of the name in the arena
+    uint32_t length; // Length of the name
+    int id;          // Id of the name (-1 = empty slot)
+  };
+
+  std::vector<char> arena;         // Names, each followed by a NUL
+  std::vector<size_t> offset;      // Start of each name in the arena
+  std::vector<Slot> table;         // Names by hash slot
+  size_t mask;                     // Table size - 1
+
+  // Returns the slot of name s (its id's, or the empty one it would take)
+  size_t slot(const char *s, size_t len, uint64_t h) const;
+
+  // Doubles the table
+  void grow(void);
+
+public:
+  // Creates an empty index sized for about expected names
+  NameIndex(size_t expected = 1024);
+
+  // Returns the hash of a name
+  static inline uint64_t hash(const char *s, size_t len) {
+    uint64_t h = 14695981039346656037ULL;
+    for (size_t i = 0; i < len; i++)
+      h = (h ^ (unsigned char) s[i]) * 1099511628211ULL;
+    return h;
+  }
+
+  // Returns the id of name s, adding it if new
+  int insert(const char *s, size_t len);
+  inline int insert(const char *s) { return insert(s, strlen(s)); }
+
+  // Returns the id of name s, -1 if not found
+  int find(const char *s, size_t len) const;
+  inline int find(const char *s) const { return find(s, strlen(s)); }
+
+  // Returns the number of names
+  inline int size(void) const { return (int) offset.size(); }
+
+  // Returns the name with id (valid until the next insertion)
+  inline const char *name(int id) const { return &arena[offset[id]]; }
+
+  // Removes every name
+  void clear(void);
+};
+
+
+#endif /* name-index.hpp  */
@@ -0,0 +1,440 @@
+/**
+   Copyright (C) 2016 Diego Rubert
+
+   This file is part of the O(k)-approximation algorithm implementation
+   for the DCJ distance on linear unichromosomal genomes in:
+
+   Diego P. Rubert, Pedro Feijão, Marília D. V. Braga, Jens Stoye and Fábio V. Martinez
+   A Linear Time Approximation Algorithm for the DCJ Distance for Genomes with Bounded Number of Duplicates
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdio>
+#include <cstdint>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <mutex>
+
+#include "graph.hpp"
+#include "decomposition.hpp"
+#include "packing-memo.hpp"
+
+
+using std::vector;
+using std::pair;
+
+
+
+/*******************
+ ** AUX FUNCTIONS **
+ *******************/
+// Mixes bits (splitmix64 finalizer), for colors
+static inline uint64_t mix(uint64_t x)
+{
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+// A piece of the adjacency graph with local numbering: genes 0..g-1,
+// extremity codes 2 * gene + (1 if head), vertices 0..v-1
+struct Piece {
+  vector<int> vertices;                      // Adjacency graph vertex ids
+  vector<int> genes;                         // Gene ids
+  vector<char> inA;                          // Whether each gene is in genome A
+  vector<vector<pair<int, double>>> cand;    // Candidates of each gene in A (gene, weight)
+  vector<vector<int>> rev;                   // Genes in A having each gene as candidate
+  vector<int> slot;                          // Extremity codes of vertex v at 2v and 2v+1, -1 if null
+  vector<int> vertexOf;                      // Vertex of each extremity code, -1 if none
+  vector<int> active;                        // Genes in A with candidates
+  vector<int> mate, best;                    // Search state: partner of each gene, -1 if free
+  vector<char> visited;                      // Scratch for walks
+  int bestScore;                             // 2c + i of best
+
+  // Links of extremity x: other extremity of the gene, other extremity
+  // of the adjacency and same type extremities of candidates (-1 = none)
+  int geneLink(int x) const { return vertexOf[x ^ 1] >= 0 ? x ^ 1 : -1; }
+  int adjLink(int x) const { int v = vertexOf[x]; return slot[2*v] == x ? slot[2*v+1] : slot[2*v]; }
+  void candLinks(int x, vector<int> &out) const
+  {
+    out.clear();
+    if (inA[x / 2])
+      for (auto &c : cand[x / 2])
+        out.push_back(2 * c.first + (x & 1));
+    else
+      for (auto a : rev[x / 2])
+        out.push_back(2 * a + (x & 1));
+  }
+
+  // Same as Decomposition::walk, on the piece with the current mates
+  int walk(int v, int x)
+  {
+    int len = 0, u = v;
+
+    visited[v] = 1;
+    while (x >= 0 && mate[x / 2] >= 0) {
+      int y = 2 * mate[x / 2] + (x & 1);
+      len++;
+      u = vertexOf[y];
+      if (u == v)
+        break;
+      visited[u] = 1;
+      x = slot[2*u] == y ? slot[2*u+1] : slot[2*u];
+    }
+
+    return len;
+  }
+
+  // Returns 2c + i for the current mates
+  int score(void)
+  {
+    int nv = (int) vertices.size(), s = 0;
+
+    visited.assign(nv, 0);
+    for (int v = 0; v < nv; v++) {
+      if (visited[v])
+        continue;
+      int x0 = slot[2*v], x1 = slot[2*v+1];
+      bool m0 = x0 >= 0 && mate[x0 / 2] >= 0, m1 = x1 >= 0 && mate[x1 / 2] >= 0;
+      if (m0 && m1)
+        continue;
+      if (walk(v, m0 ? x0 : (m1 ? x1 : -1)) % 2)
+        s++;
+    }
+    for (int v = 0; v < nv; v++)
+      if (!visited[v]) {
+        walk(v, slot[2*v]);
+        s += 2;
+      }
+
+    return s;
+  }
+
+  // Tries every maximal matching of active genes i, i+1, ...
+  void search(size_t i)
+  {
+    if (i == active.size()) {
+      for (auto a : active)
+        if (mate[a] < 0)
+          for (auto &c : cand[a])
+            if (mate[c.first] < 0)
+              return; // not maximal
+      int s = score();
+      if (s > bestScore) {
+        bestScore = s;
+        best = mate;
+      }
+      return;
+    }
+
+    int a = active[i];
+    for (auto &c : cand[a])
+      if (mate[c.first] < 0) {
+        mate[a] = c.first;
+        mate[c.first] = a;
+        search(i + 1);
+        mate[a] = mate[c.first] = -1;
+      }
+    search(i + 1);
+  }
+};
+
+// Fills p with the piece made of the given vertices, using local (gene
+// id -> local gene, all -1, restored on return). Candidates are taken
+// from the edges left in ag. Returns false if some candidate pair has
+// an extremity type present in the piece for only one of the genes
+static bool buildPiece(Graph *ag, char partA, Piece &p, vector<int> &local)
+{
+  int nv = (int) p.vertices.size();
+  bool ok = true;
+
+  p.genes.clear();
+  p.inA.clear();
+  p.slot.assign(2 * nv, -1);
+  for (int j = 0; j < nv; j++) {
+    Vertex *v = ag->getVertex(p.vertices[j]);
+    Extremity ex[2] = {v->getExtremityLeft(), v->getExtremityRight()};
+    for (int k = 0; k < 2; k++) {
+      if (ex[k].getType() == Extremity::UNDEF)
+        continue;
+      if (local[ex[k].getId()] < 0) {
+        local[ex[k].getId()] = (int) p.genes.size();
+        p.genes.push_back(ex[k].getId());
+        p.inA.push_back(v->getPart() == partA);
+      }
+      p.slot[2*j+k] = 2 * local[ex[k].getId()] + (ex[k].getType() == Extremity::HEAD);
+    }
+  }
+
+  int ng = (int) p.genes.size();
+  p.vertexOf.assign(2 * ng, -1);
+  for (int j = 0; j < 2 * nv; j++)
+    if (p.slot[j] >= 0)
+      p.vertexOf[p.slot[j]] = j / 2;
+
+  // candidate pairs, from edges at genome A vertices (tail edge weights first)
+  p.cand.assign(ng, vector<pair<int, double>>());
+  p.rev.assign(ng, vector<int>());
+  for (int j = 0; j < nv; j++) {
+    Vertex *v = ag->getVertex(p.vertices[j]);
+    if (v->getPart() != partA)
+      continue;
+    for (auto e : *v) {
+      Extremity from = e->getExtremityFrom(), to = e->getExtremityTo();
+      if (from.getType() == Extremity::UNDEF || to.getType() == Extremity::UNDEF)
+        continue;
+      int a = local[from.getId()], b = local[to.getId()]; // b is in the piece (closure)
+      auto c = std::find_if(p.cand[a].begin(), p.cand[a].end(), [b](const pair<int, double> &x) { return x.first == b; });
+      if (c == p.cand[a].end()) {
+        p.cand[a].push_back(std::make_pair(b, e->getWeight()));
+        p.rev[b].push_back(a);
+      }
+      else if (from.getType() == Extremity::TAIL)
+        c->second = e->getWeight();
+    }
+  }
+
+  p.active.clear();
+  for (int a = 0; a < ng; a++) {
+    if (p.cand[a].empty())
+      continue;
+    p.active.push_back(a);
+    for (auto &c : p.cand[a]) // walks go to the mate's same type extremity
+      for (int t = 0; t < 2; t++)
+        if ((p.vertexOf[2*a+t] >= 0) != (p.vertexOf[2*c.first+t] >= 0))
+          ok = false;
+  }
+
+  for (auto id : p.genes)
+    local[id] = -1;
+  return ok;
+}
+
+// Computes the canonical encoding of p (see packing-memo.hpp) and the
+// canonical order of its extremity codes. Returns false if some
+// extremity isn't reached (never for pieces built by apply)
+static bool encode(const Piece &p, vector<int> &order, vector<int> &enc)
+{
+  int nx = (int) p.vertexOf.size();
+  vector<int> nodes, links, pos(nx), o;
+  vector<uint64_t> col(nx, 0), next(nx), nb;
+
+  for (int x = 0; x < nx; x++)
+    if (p.vertexOf[x] >= 0) {
+      nodes.push_back(x);
+      col[x] = mix(1 + 4 * p.inA[x / 2] + 2 * (x & 1) + (p.adjLink(x) >= 0));
+    }
+
+  // color refinement
+  for (int round = 0; round < 3; round++) {
+    for (auto x : nodes) {
+      int g = p.geneLink(x), a = p.adjLink(x);
+      uint64_t h = mix(col[x] ^ (g >= 0 ? mix(col[g] + 1) : 0) ^ (a >= 0 ? mix(col[a] + 2) : 0));
+      p.candLinks(x, links);
+      nb.clear();
+      for (auto y : links)
+        nb.push_back(col[y]);
+      std::sort(nb.begin(), nb.end());
+      for (auto c : nb)
+        h = mix(h * 31 + c);
+      next[x] = h;
+    }
+    for (auto x : nodes)
+      col[x] = next[x];
+  }
+
+  uint64_t least = ~0ULL;
+  for (auto x : nodes)
+    least = std::min(least, col[x]);
+
+  vector<int> e;
+  enc.clear();
+  for (auto s : nodes) {
+    if (col[s] != least)
+      continue;
+
+    // breadth first numbering from s, neighbors in color order
+    std::fill(pos.begin(), pos.end(), -1);
+    o.assign(1, s);
+    pos[s] = 0;
+    for (size_t i = 0; i < o.size(); i++) {
+      int x = o[i];
+      p.candLinks(x, links);
+      std::sort(links.begin(), links.end(), [&col](int a, int b) { return col[a] != col[b] ? col[a] < col[b] : a < b; });
+      links.insert(links.begin(), p.adjLink(x));
+      links.insert(links.begin(), p.geneLink(x));
+      for (auto y : links)
+        if (y >= 0 && pos[y] < 0) {
+          pos[y] = (int) o.size();
+          o.push_back(y);
+        }
+    }
+    if (o.size() != nodes.size())
+      return false;
+
+    // description in that numbering
+    e.clear();
+    for (auto x : o) {
+      int g = p.geneLink(x), a = p.adjLink(x);
+      e.push_back(2 * p.inA[x / 2] + (x & 1));
+      e.push_back(g >= 0 ? pos[g] : -1);
+      e.push_back(a >= 0 ? pos[a] : -1);
+      p.candLinks(x, links);
+      e.push_back((int) links.size());
+      size_t k = e.size();
+      for (auto y : links)
+        e.push_back(pos[y]);
+      std::sort(e.begin() + k, e.end());
+    }
+
+    if (enc.empty() || e < enc) {
+      enc = e;
+      order = o;
+    }
+  }
+
+  return true;
+}
+
+
+
+/*************************
+ ** PACKINGMEMO METHODS **
+ *************************/
+PackingMemo::PackingMemo(int maxVertices, long leafLimit, size_t maxEntries) :
+  maxVertices(maxVertices),
+  leafLimit(leafLimit),
+  maxEntries(maxEntries),
+  lookups(0),
+  hits(0),
+  skipped(0)
+{}
+
+int PackingMemo::apply(Graph *ag, Decomposition &dec)
+{
+  vector<char> seen(ag->getMaxVertexId() + 1, 0);
+  vector<int> local(dec.getMaxGeneId(), -1), solved, stack, order, enc, pos;
+  vector<Vertex *> reach;
+  Piece p;
+  int pieces = 0;
+
+  for (auto it = ag->begin(); it != ag->end(); ++it) {
+    if (seen[(*it)->getId()])
+      continue;
+
+    // the piece: closure under edges and siblings
+    p.vertices.clear();
+    stack.assign(1, (*it)->getId());
+    seen[(*it)->getId()] = 1;
+    bool edges = false;
+    while (!stack.empty()) {
+      Vertex *v = ag->getVertex(stack.back());
+      stack.pop_back();
+      p.vertices.push_back(v->getId());
+      for (auto e : *v) {
+        edges = true;
+        reach.assign(1, e->getAdj());
+        if (e->getSibling()) {
+          reach.push_back(e->getSibling()->getAdj());
+          reach.push_back(e->getSibling()->getAdjRef()->getAdj());
+        }
+        for (auto u : reach)
+          if (!seen[u->getId()]) {
+            seen[u->getId()] = 1;
+            stack.push_back(u->getId());
+          }
+      }
+    }
+
+    if (!edges)
+      continue;
+    if ((int) p.vertices.size() > maxVertices || !buildPiece(ag, dec.getPart(), p, local) || p.active.empty() || !encode(p, order, enc)) {
+      skipped++; // not counted as lookups, so the hit rate is about memoizable pieces
+      continue;
+    }
+
+    std::string key((const char *) enc.data(), enc.size() * sizeof(int));
+    vector<pair<int, int>> pairs;
+    bool found = false;
+    {
+      std::lock_guard<std::mutex> guard(lock);
+      lookups++;
+      auto h = cache.find(key);
+      if (h != cache.end()) {
+        hits++;
+        pairs = h->second.pairs;
+        found = true;
+      }
+    }
+
+    if (!found) {
+      long leaves = 1;
+      for (auto a : p.active)
+        leaves = std::min(leafLimit + 1, leaves * (long) (p.cand[a].size() + 1));
+      if (leaves > leafLimit) {
+        std::lock_guard<std::mutex> guard(lock);
+        lookups--;
+        skipped++;
+        continue;
+      }
+
+      p.mate.assign(p.genes.size(), -1);
+      p.bestScore = -1;
+      p.search(0);
+
+      pos.assign(p.vertexOf.size(), -1);
+      for (size_t i = 0; i < order.size(); i++)
+        pos[order[i]] = (int) i;
+      for (auto a : p.active)
+        if (p.best[a] >= 0) { // tails may be gone (removed by an earlier round), heads then are there
+          int t = p.vertexOf[2*a] >= 0 ? 0 : 1;
+          pairs.push_back(std::make_pair(pos[2*a+t], pos[2 * p.best[a] + t]));
+        }
+
+      std::lock_guard<std::mutex> guard(lock);
+      if (cache.size() < maxEntries) {
+        Entry &entry = cache[key];
+        entry.pairs = pairs;
+        entry.score = p.bestScore;
+      }
+    }
+
+    // pairs are positions of extremities in the canonical order
+    for (auto &q : pairs) {
+      if (q.first < 0 || q.second < 0 || q.first >= (int) order.size() || q.second >= (int) order.size())
+        continue;
+      int a = order[q.first] / 2, b = order[q.second] / 2;
+      for (auto &c : p.cand[a])
+        if (c.first == b) {
+          if (dec.getMate(p.genes[a]) != p.genes[b]) // may be fixed by an earlier round
+            dec.match(p.genes[a], p.genes[b], c.second);
+          break;
+        }
+    }
+    solved.insert(solved.end(), p.vertices.begin(), p.vertices.end());
+    pieces++;
+  }
+
+  for (auto id : solved)
+    ag->removeVertex(id);
+  return pieces;
+}
+
+void PackingMemo::print(void) const
+{
+  printf("memo: %ld lookups, %ld hits (%.1f%%), %ld pieces skipped, %zu cached\n",
+         lookups, hits, 100 * hitRate(), skipped, cache.size());
+}
@@ -0,0 +1,113 @@
+/**
+   Copyright (C) 2016 Diego Rubert
+
+   This file is part of the O(k)-approximation algorithm implementation
+   for the DCJ distance on linear unichromosomal genomes in:
+
+   Diego P. Rubert, Pedro Feijão, Marília D. V. Braga, Jens Stoye and Fábio V. Martinez
+   A Linear Time Approximation Algorithm for the DCJ Distance for Genomes with Bounded Number of Duplicates
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+  Memoization of optimal solutions of small independent pieces of the
+  adjacency graph. A piece is a set of vertices closed under edges and
+  edge siblings, so its genes have candidates only inside it and its
+  matching doesn't interact with the rest of the graph. Small pieces
+  (e.g. repeated tandem duplication patterns) recur many times, so
+  each one gets a canonical encoding and the optimal matching of the
+  first piece with that encoding is reused by the others.
+
+  The encoding is computed over the piece's gene extremities (genome,
+  tail/head, and links to the other extremity of the gene, to the
+  other extremity of the adjacency and to candidate partners): colors
+  are refined a few rounds (Weisfeiler-Lehman style), then extremities
+  are numbered by a breadth first traversal from each extremity of the
+  smallest color, neighbors in color order, and the lexicographically
+  smallest description is kept. Equal encodings always mean isomorphic
+  pieces (the description is complete), so a hit is always correct;
+  remaining ties may only make isomorphic pieces miss.
+
+  Misses are solved exactly by exhaustive search over the maximal
+  matchings of the piece (as the final completion always gives one),
+  maximizing 2c + i (cycles and odd paths), i.e. minimizing the DCJ
+  distance. Pieces with too large a search space are left alone.
+*/
+
+#ifndef _PACKING_MEMO_HPP
+
+#define _PACKING_MEMO_HPP 1
+
+#include <vector>
+#include <string>
+#include <utility>
+#include <unordered_map>
+#include <mutex>
+
+#include "graph.hpp"
+#include "decomposition.hpp"
+
+
+
+/***********************
+ ** PACKINGMEMO CLASS **
+ ***********************/
+class PackingMemo {
+private:
+  // Optimal matching of a canonical piece: pairs of positions (in the
+  // canonical order) of the tails of matched genes (heads if the tails
+  // are gone, as both genes of a pair then lack them), and 2c + i
+  struct Entry {
+    std::vector<std::pair<int, int>> pairs;
+    int score;
+  };
+
+  std::unordered_map<std::string, Entry> cache; // Canonical encoding -> optimal matching
+  std::mutex lock;     // Guards cache and counters (engines may share a memo)
+  int maxVertices;     // Largest piece considered (vertices)
+  long leafLimit;      // Largest search space solved (matchings)
+  size_t maxEntries;   // Cache size limit (no more entries are stored)
+  long lookups;        // Pieces looked up
+  long hits;           // Pieces found
+  long skipped;        // Pieces too large (or not independent)
+
+public:
+  // Pieces up to maxVertices adjacency graph vertices with at most
+  // leafLimit matchings to try are memoized
+  PackingMemo(int maxVertices = 32, long leafLimit = 1 << 16, size_t maxEntries = 1 << 20);
+
+  // Matches optimally (in dec, which must index ag before any reduction)
+  // the genes of every small piece of ag, taking candidates from the
+  // edges left, and removes their vertices from ag. Returns the number
+  // of pieces solved (thread safe)
+  int apply(Graph *ag, Decomposition &dec);
+
+  // Returns the number of pieces looked up, found and skipped
+  inline long getLookups(void) const { return lookups; }
+  inline long getHits(void) const { return hits; }
+  inline long getSkipped(void) const { return skipped; }
+
+  // Returns the fraction of lookups that hit
+  inline double hitRate(void) const { return lookups ? (double) hits / lookups : 0; }
+
+  // Returns the number of cached pieces
+  inline size_t size(void) const { return cache.size(); }
+
+  // Prints the counters
+  void print(void) const;
+};
+
+
+#endif /* packing-memo.hpp  */
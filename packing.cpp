@@ -0,0 +1,156 @@
+/**
+   Copyright (C) 2016 Diego Rubert
+
+   This file is part of the O(k)-approximation algorithm implementation
+   for the DCJ distance on linear unichromosomal genomes in:
+
+   Diego P. Rubert, Pedro Feijão, Marília D. V. Braga, Jens Stoye and Fábio V. Martinez
+   A Linear Time Approximation Algorithm for the DCJ Distance for Genomes with Bounded Number of Duplicates
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdio>
+#include <vector>
+#include <algorithm>
+
+#include "graph.hpp"
+#include "paths-cycles.hpp"
+#include "conflict-graph.hpp"
+#include "solvers.hpp"
+#include "decomposition.hpp"
+#include "packing-memo.hpp"
+#include "high-copy.hpp"
+#include "packing.hpp"
+
+
+using std::vector;
+
+
+
+/***************************
+ ** PACKINGENGINE METHODS **
+ ***************************/
+PackingEngine::PackingEngine(Graph *ag, int maxLen, PackingMemo *memo, int copyThreshold) :
+  ag(ag),
+  maxLen(maxLen),
+  fallback(ag, copyThreshold),
+  dec(ag),
+  result(),
+  memo(memo),
+  memoized(0)
+{
+  int k = 0; // number of genes the most ambiguous gene may be matched to
+
+  for (int id = 0; id < dec.getMaxGeneId(); id++)
+    k = std::max(k, dec.candidates(id));
+
+  if (this->maxLen <= 0)
+    this->maxLen = 2 * k;
+
+  enumerated.assign(this->maxLen / 2 + 1, 0);
+  packed.assign(this->maxLen / 2 + 1, 0);
+}
+
+void PackingEngine::run(void)
+{
+  dec.clear();
+  memoized = 0;
+
+  for (int len = 2; len <= maxLen; len += 2) {
+    fixedGenes.clear();
+    usedVertices.clear();
+
+    if (memo) // small pieces are solved and removed before enumeration
+      memoized += memo->apply(ag, dec);
+
+    { // cycles reference ag edges, so the CyclesGraph must be gone before we reduce ag
+      enumerator.enumerate(ag, len, &cycles);
+      CyclesGraph cg(ag, &cycles);
+      ConflictGraph g(&cg);
+      vector<int> chosen = greedyPacking(&g);
+
+      enumerated[len / 2] = g.getN();
+      packed[len / 2] = chosen.size();
+      for (auto v : chosen)
+        fix(g.cycle(v));
+    }
+
+    reduce();
+  }
+
+  dec.complete();
+  result = dec.score();
+}
+
+void PackingEngine::fix(Path *c)
+{
+  for (auto v : *c)
+    usedVertices.push_back(v->getId());
+
+  dec.add(c); // packed cycles are pairwise consistent
+  for (int i = 0; i < c->lenE(); i++) {
+    Extremity from = c->nthE(i)->getExtremityFrom(), to = c->nthE(i)->getExtremityTo();
+    if (from.getType() != Extremity::UNDEF && to.getType() != Extremity::UNDEF) {
+      fixedGenes.push_back(from.getId());
+      fixedGenes.push_back(to.getId());
+    }
+  }
+}
+
+void PackingEngine::reduce(void)
+{
+  vector<Edge *> inconsistent;
+
+  for (auto id : usedVertices) // packed cycles are closed components now
+    ag->removeVertex(id);
+
+  for (auto gene : fixedGenes) {
+    Extremity ex[2] = {Extremity(gene, Extremity::TAIL), Extremity(gene, Extremity::HEAD)};
+
+    for (int i = 0; i < 2; i++) {
+      Vertex *v = dec.getVertex(ex[i]) >= 0 ? ag->getVertex(dec.getVertex(ex[i])) : NULL;
+      if (v == NULL) // removed with some packed cycle
+        continue;
+
+      inconsistent.clear();
+      for (auto e : *v)
+        if (e->getExtremityFrom() == ex[i] && e->getExtremityTo().getId() != dec.getMate(gene))
+          inconsistent.push_back(e);
+      for (auto e : inconsistent)
+        ag->removeEdge(e);
+    }
+  }
+}
+
+int PackingEngine::getEnumerated(int len) const
+{
+  return len >= 0 && len / 2 < (int) enumerated.size() ? enumerated[len / 2] : 0;
+}
+
+int PackingEngine::getPacked(int len) const
+{
+  return len >= 0 && len / 2 < (int) packed.size() ? packed[len / 2] : 0;
+}
+
+void PackingEngine::print(void)
+{
+  if (fallback.getThreshold() > 0)
+    fallback.print();
+  for (int len = 2; len <= maxLen; len += 2)
+    printf("len %d: %d cycles enumerated, %d packed\n", len, getEnumerated(len), getPacked(len));
+  if (memo)
+    printf("%d pieces solved through the memo\n", memoized);
+  result.print();
+}
@@ -0,0 +1,134 @@
+/**
+   Copyright (C) 2016 Diego Rubert
+
+   This file is part of the O(k)-approximation algorithm implementation
+   for the DCJ distance on linear unichromosomal genomes in:
+
+   Diego P. Rubert, Pedro Feijão, Marília D. V. Braga, Jens Stoye and Fábio V. Martinez
+   A Linear Time Approximation Algorithm for the DCJ Distance for Genomes with Bounded Number of Duplicates
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+  Iterative packing engine implementing the O(k)-approximation: for
+  cycle lengths 2, 4, ..., maxLen we build the CyclesGraph of the
+  current adjacency graph, pack a maximal set of consistent cycles,
+  fix the gene matchings they induce and remove them from the
+  adjacency graph (together with every edge that became inconsistent
+  with the fixed matchings). Then the decomposition is completed
+  greedily and the approximate DCJ distance is computed. Optionally,
+  before each round's enumeration, small independent pieces of the
+  adjacency graph (reductions break it up) are solved exactly through
+  a memo (see packing-memo.hpp), which may be shared by many engines.
+  Families with more copies than a threshold may be resolved up front
+  by heuristic matching (see high-copy.hpp), before the engine indexes
+  the adjacency graph, so they never reach the enumeration.
+
+  All rounds work in place on the same adjacency graph, so the graph
+  given to the engine is consumed (vertices and edges are removed).
+  Scratch arrays are indexed by gene extremity and allocated once, and
+  the cycle enumerator keeps its scratch from a round to the next.
+*/
+
+#ifndef _PACKING_HPP
+
+#define _PACKING_HPP 1
+
+#include <vector>
+#include <forward_list>
+
+#include "graph.hpp"
+#include "paths-cycles.hpp"
+#include "conflict-graph.hpp"
+#include "decomposition.hpp"
+#include "packing-memo.hpp"
+#include "high-copy.hpp"
+
+
+
+/*************************
+ ** PACKINGENGINE CLASS **
+ *************************/
+class PackingEngine {
+private:
+  Graph *ag;                     // Adjacency graph, reduced in place round after round
+  int maxLen;                    // Length of cycles in the last round
+  HighCopyFallback fallback;     // High-copy families resolved before indexing
+  Decomposition dec;             // Gene matching being built (indexed before any reduction)
+  DCJScore result;               // Scores of the final decomposition
+  std::vector<int> enumerated;   // Cycles enumerated in each round
+  std::vector<int> packed;       // Cycles packed in each round
+  std::vector<int> fixedGenes;      // Scratch: genes fixed in current round
+  std::vector<int> usedVertices;    // Scratch: vertices of cycles packed in current round
+  CycleEnumerator enumerator;       // Enumerates the cycles of each round (scratch kept)
+  std::forward_list<Path *> cycles; // Scratch: cycles of current round
+  PackingMemo *memo;                // Memo for small pieces (NULL = none)
+  int memoized;                     // Pieces solved through the memo
+
+  // Fixes the gene matchings of a packed cycle
+  void fix(Path *c);
+
+  // Removes the vertices of cycles packed in the last round and every
+  // edge inconsistent with the genes fixed in that round
+  void reduce(void);
+
+public:
+  // Receives the adjacency graph (which will be consumed) and the
+  // length of cycles in the last round (0 = 2k, where k is the size
+  // of the largest family left), optionally a memo for small pieces
+  // and a copy threshold above which families are resolved by
+  // heuristic matching (0 = none)
+  PackingEngine(Graph *ag, int maxLen = 0, PackingMemo *memo = NULL, int copyThreshold = 0);
+
+  // Runs all rounds, completes the decomposition and scores it
+  void run(void);
+
+  // Returns the length of cycles in the last round
+  inline int getMaxLen(void) const { return maxLen; }
+
+  // Returns the number of genes (in genome A)
+  inline int getGenes(void) const { return dec.getGenes(); }
+
+  // Returns the number of cycles in the decomposition
+  inline int getCycles(void) const { return result.cycles; }
+
+  // Returns the number of odd paths in the decomposition
+  inline int getOddPaths(void) const { return result.oddPaths; }
+
+  // Returns the scores of the decomposition
+  inline const DCJScore &getScore(void) const { return result; }
+
+  // Returns the gene matched to gene id (0 = unmatched)
+  inline int getMate(int id) const { return id < dec.getMaxGeneId() ? dec.getMate(id) : 0; }
+
+  // Returns the number of pieces solved through the memo
+  inline int getMemoized(void) const { return memoized; }
+
+  // Returns the high-copy families resolved before the rounds
+  inline const HighCopyFallback &getFallback(void) const { return fallback; }
+
+  // Returns the number of cycles of length len enumerated/packed
+  int getEnumerated(int len) const;
+  int getPacked(int len) const;
+
+  // Returns the approximate DCJ distance, n - (c + i/2)
+  inline int distance(void) const { return result.distance; }
+
+  // Prints a summary of the rounds and of the decomposition
+  void print(void);
+};
+
+
+#endif /* packing.hpp  */
@@ -28,6 +28,8 @@
 
 #include <vector>
 #include <utility>
+#include <iterator>
+#include <algorithm>
 #include <unordered_set>
 #include <unordered_map>
 #include <set>
@@ -209,6 +211,13 @@ CyclesGraph::CyclesGraph(Graph *ag, const char *label, int len) :
   buildCyclesGraph(ag, len);
 }
 
+CyclesGraph::CyclesGraph(Graph *ag, std::forward_list<Path *> *cycles, const char *label) :
+  Graph(label, std::max(16, (int) std::distance(cycles->begin(), cycles->end())))
+{
+  buildCyclesGraph(ag, cycles);
+  cycles->clear(); // cycles are now satellite data of our vertices
+}
+
 CyclesGraph::~CyclesGraph()
 {
   for (auto v : *this) {
@@ -220,63 +229,9 @@ CyclesGraph::~CyclesGraph()
 void CyclesGraph::buildCyclesGraph(Graph *ag, int len)
 //CyclesGraph *cyclesGraph(Graph *ag, const char glabel[], int len)//TODO: remove
 {
-  Vertex *v;
-  char part;
-
-  if (ag->getN() < 1 || len < 2) { // We can't find cycles when there are no vertices or the length of cycles is less than 2 (we have no self-edges)
-    forward_list<Path *> empty;
-    buildCyclesGraph(ag, &empty);
-    return;
-  }
-  
-  forward_list<Path *> *newlist, *list = new forward_list<Path *>;       // temporary lists containing paths
-  forward_list<Path *> *cycles = new forward_list<Path *>;               // list containing cycles found
-  unordered_set<string> cycle_signatures((ag->getN()/2)*(ag->getN()/2)); // hash table size: (n/2)^2
+  forward_list<Path *> *cycles = new forward_list<Path *>; // list containing cycles found
 
-  // assuming we have at least 1 vertex
-  part = ag->begin()->getPart();
-
-  // We try to find cycles starting just in one part
-  for (auto it = ag->begin(part); it != ag->end(); ++it) {
-    v = *it;
-    list->push_front(new Path(v));
-
-    for (int i = 0; i < len; i++) {
-      newlist = new forward_list<Path *>;
-      for (auto p : *list) {          // for each path in list
-        for (auto e : *p->last()) {   // we try to add each edge incident to last vertex in path
-          
-          if (!p->consistent(e))
-            continue;
-          
-          bool cycle = p->isCycle(e);
-          if (i < len-1 && !cycle)                               // if not in desired lenght
-            newlist->push_front(new Path(*p + e->getAdj() + e));   // for now, |V| = |E+1| in the cycle
-          else if (i == len-1 && cycle && *e > *p->firstE())     // if it may close the cycle of desired lenght (optimization)
-            newlist->push_front(new Path(*p + e));                 // at end, |V| = |E| in the cycle
-        }
-      }
-      // clear old list
-      for (auto p : *list) // just deleting list results in memory leaks, as list elements are pointers and it's destructor won't destroy objects
-        delete p;
-      delete list;
-      list = newlist; // in newlist, all paths have lenght equal to (list lenght) + 1
-    }
-
-    for (auto c : *list) {
-      string sign = c->signature();
-      
-      if (cycle_signatures.find(sign) == cycle_signatures.end()) { // cycle generated for the first time
-        cycle_signatures.insert(sign); // add signature to hash
-        cycles->push_front(c);         // add cycle to set
-      }
-      else
-        delete c; // cycle previously generated
-    }
-    list->clear();
-  }
-
-  delete list;
+  enumerateCycles(ag, len, cycles);
   buildCyclesGraph(ag, cycles);
   delete cycles; // we don't delete cycles as they are satellite data of cg vertices, we delete just the container
 }
@@ -360,9 +315,73 @@ void CyclesGraph::buildCyclesGraph(Graph *ag, std::forward_list<Path *> *cycles)
 
 
 
+/*****************************
+ ** CYCLEENUMERATOR METHODS **
+ *****************************/
+void CycleEnumerator::enumerate(Graph *ag, int len, std::forward_list<Path *> *cycles)
+{
+  char part;
+
+  if (ag->getN() < 1 || len < 2) // We can't find cycles when there are no vertices or the length of cycles is less than 2 (we have no self-edges)
+    return;
+
+  // assuming we have at least 1 vertex
+  part = ag->begin()->getPart();
+
+  // We try to find cycles starting just in one part
+  for (auto it = ag->begin(part); it != ag->end(); ++it) {
+    Vertex *v = *it;
+    list.push_back(new Path(v));
+
+    for (int i = 0; i < len; i++) {
+      for (auto p : list) {           // for each path in list
+        for (auto e : *p->last()) {   // we try to add each edge incident to last vertex in path
+
+          if (!p->consistent(e))
+            continue;
+
+          bool cycle = p->isCycle(e);
+          if (i < len-1 && !cycle)                               // if not in desired lenght
+            next.push_back(new Path(*p + e->getAdj() + e));      // for now, |V| = |E+1| in the cycle
+          else if (i == len-1 && cycle && *e > *p->firstE())     // if it may close the cycle of desired lenght (optimization)
+            next.push_back(new Path(*p + e));                    // at end, |V| = |E| in the cycle
+        }
+        delete p;
+      }
+      std::reverse(next.begin(), next.end()); // same order as pushing to the front of a list
+      list.swap(next); // in list, all paths have lenght equal to (list lenght) + 1
+      next.clear();
+    }
+
+    // a cycle is kept only from its first vertex of this part (in
+    // iteration order, i.e. by id), where it is found at most twice
+    for (auto c : list) {
+      bool first = true;
+      for (auto w : *c)
+        if (w->getPart() == part && w->getId() < v->getId())
+          first = false;
+      if (first && signatures.insert(c->signature()).second)
+        cycles->push_front(c);
+      else
+        delete c;
+    }
+    list.clear();
+    signatures.clear();
+  }
+}
+
+
+
 /*******************
  ** OTHER METHODS **
  *******************/
+void enumerateCycles(Graph *ag, int len, std::forward_list<Path *> *cycles)
+{
+  CycleEnumerator enumerator;
+
+  enumerator.enumerate(ag, len, cycles);
+}
+
 void walk(Graph *ag, Vertex *v)
 {
   int op, i, to;
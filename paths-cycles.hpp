@@ -34,7 +34,9 @@
 #define _PATHS_CYCLES_HPP 1
 
 #include <vector>
+#include <string>
 #include <utility>
+#include <unordered_set>
 #include <forward_list>
 
 #include "graph.hpp"
@@ -233,14 +235,46 @@ public:
   // the label and the length of cycles we want to pack
   CyclesGraph(Graph *ag, const char *label = 0x0, int len = 0);
 
+  // Builds the graph of cycles already enumerated (e.g. by a
+  // CycleEnumerator), taking them over and leaving the list empty
+  CyclesGraph(Graph *ag, std::forward_list<Path *> *cycles, const char *label = 0x0);
+
   // Destructor
   ~CyclesGraph();
 };
 
 
+/***************************
+ ** CYCLEENUMERATOR CLASS **
+ ***************************/
+// Enumerates consistent cycles like enumerateCycles, keeping its
+// scratch (path lists and signature set) from a call to the next, so
+// rounds over the same adjacency graph don't allocate it again.
+// Duplicates are avoided without a global set of signatures: a cycle
+// is kept only when found from its first vertex of the starting part,
+// so signatures are only compared among cycles of one start
+class CycleEnumerator {
+private:
+  std::vector<Path *> list;                // Paths being extended
+  std::vector<Path *> next;                // Paths one edge longer
+  std::unordered_set<std::string> signatures; // Cycles found from the current start
+
+public:
+  // Pushes every consistent cycle of length len of ag to cycles (the
+  // caller owns them)
+  void enumerate(Graph *ag, int len, std::forward_list<Path *> *cycles);
+};
+
+
 /*******************
  ** OTHER METHODS **
  *******************/
+// Enumerates every consistent cycle of length len (in edges) of an
+// adjacency graph, each one once, pushing them to cycles (the caller
+// owns them). This is the enumeration CyclesGraph is built from, see
+// buildCyclesGraph(ag, len) for details
+void enumerateCycles(Graph *ag, int len, std::forward_list<Path *> *cycles);
+
 // An interactive walk in the graph, for debugging purposes
 void walk(Graph *ag, Vertex *v);
 
@@ -0,0 +1,286 @@
+/**
+   Copyright (C) 2016 Diego Rubert
+
+   This file is part of the O(k)-approximation algorithm implementation
+   for the DCJ distance on linear unichromosomal genomes in:
+
+   Diego P. Rubert, Pedro Feijão, Marília D. V. Braga, Jens Stoye and Fábio V. Martinez
+   A Linear Time Approximation Algorithm for the DCJ Distance for Genomes with Bounded Number of Duplicates
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdio>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <mutex>
+#include <chrono>
+#include <memory>
+#include <functional>
+
+#include "graph.hpp"
+#include "conflict-graph.hpp"
+#include "bounds.hpp"
+#include "solvers.hpp"
+#include "local-search.hpp"
+#include "thread-pool.hpp"
+#include "portfolio.hpp"
+
+
+using std::vector;
+using std::string;
+
+
+
+/*******************
+ ** AUX FUNCTIONS **
+ *******************/
+// Solvers not started yet, taken by the first free worker or by the
+// thread of run() itself. Shared with the pool tasks, which may start
+// after run() returned (and find nothing to do)
+struct SolverQueue {
+  std::mutex lock;
+  std::vector<std::function<void()>> solvers;
+  std::vector<bool> watched; // Needs someone else to cancel it on the deadline
+};
+
+// Takes the first solver not started (watched ones only if anyone),
+// returns false if there is none
+static bool takeSolver(SolverQueue &q, bool anyone, std::function<void()> &solver)
+{
+  std::lock_guard<std::mutex> guard(q.lock);
+
+  for (size_t i = 0; i < q.solvers.size(); i++)
+    if (anyone || !q.watched[i]) {
+      solver = std::move(q.solvers[i]);
+      q.solvers.erase(q.solvers.begin() + i);
+      q.watched.erase(q.watched.begin() + i);
+      return true;
+    }
+
+  return false;
+}
+
+
+
+/***********************
+ ** PORTFOLIO METHODS **
+ ***********************/
+Portfolio::Portfolio(Graph *ag, const ConflictGraph *g, ThreadPool *pool, int exactLimit) :
+  ag(ag),
+  g(g),
+  pool(pool),
+  bound(g),
+  exactLimit(exactLimit),
+  bestValue(0),
+  winner(-1),
+  optimal(false),
+  running(0),
+  cancel(false),
+  deadline(0)
+{}
+
+int Portfolio::add(const string &name)
+{
+  std::lock_guard<std::mutex> guard(lock);
+  PortfolioEntry e;
+
+  e.name = name;
+  e.value = -1;
+  e.time = 0;
+  e.finished = false;
+  entries.push_back(e);
+  running++;
+
+  return (int) entries.size() - 1;
+}
+
+bool Portfolio::offer(int i, const vector<int> &solution, bool proved)
+{
+  std::lock_guard<std::mutex> guard(lock);
+  double value = g->weight(solution);
+  bool better = winner < 0 || value > bestValue + 1e-9;
+
+  if (value > entries[i].value) {
+    entries[i].value = value;
+    entries[i].time = elapsed();
+  }
+
+  if (better) {
+    best = solution;
+    bestValue = value;
+    winner = i;
+  }
+
+  // proved solutions started from the incumbent, so they are at least as good
+  if (proved || bound.closed(bestValue))
+    optimal = true;
+  if (optimal && !cancel) {
+    cancel = true;
+    for (auto s : searches)
+      s->stop();
+  }
+
+  return better;
+}
+
+void Portfolio::end(int i, bool byItself)
+{
+  std::lock_guard<std::mutex> guard(lock);
+
+  entries[i].finished = byItself;
+  running--;
+  finished.notify_all();
+}
+
+vector<int> Portfolio::incumbent(double &value)
+{
+  std::lock_guard<std::mutex> guard(lock);
+
+  value = winner >= 0 ? bestValue : -1;
+  return best;
+}
+
+double Portfolio::elapsed(void) const
+{
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void Portfolio::runLocalSearch(int i, unsigned seed, bool weightFirst)
+{
+  LocalSearch search(ag, g, seed);
+  vector<int> all(g->getN());
+  double value;
+
+  if (weightFirst) {
+    for (int v = 0; v < g->getN(); v++)
+      all[v] = v;
+    search.init(repairPacking(g, all));
+  }
+
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    searches.push_back(&search);
+  }
+
+  // short slices, to share incumbents between them
+  while (!done() && !search.getBound().closed(search.getBestValue())) {
+    search.run(std::min(0.1, deadline - elapsed()));
+    offer(i, search.getBest());
+
+    vector<int> inc = incumbent(value);
+    if (value > search.getBestValue() + 1e-9)
+      search.init(inc);
+  }
+
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    searches.erase(std::find(searches.begin(), searches.end(), &search));
+  }
+  end(i, search.getBound().closed(search.getBestValue()));
+}
+
+void Portfolio::runExact(int i)
+{
+  double value;
+  vector<int> solution = incumbent(value);
+
+  bool proved = exactPacking(g, solution, &cancel);
+  offer(i, solution, proved);
+  end(i, proved);
+}
+
+void Portfolio::run(double seconds)
+{
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    entries.clear();
+    best.clear();
+    bestValue = 0;
+    winner = -1;
+    optimal = false;
+  }
+  cancel = false;
+  start = std::chrono::steady_clock::now();
+  deadline = seconds;
+
+  std::shared_ptr<SolverQueue> queue = std::make_shared<SolverQueue>();
+  auto enqueue = [this, &queue](const string &name, bool watched, std::function<void(int)> solver) {
+    int i = add(name);
+    {
+      std::lock_guard<std::mutex> guard(queue->lock);
+      queue->solvers.push_back([solver, i]() { solver(i); });
+      queue->watched.push_back(watched);
+    }
+    std::shared_ptr<SolverQueue> q = queue;
+    pool->submit([q]() {
+        std::function<void()> f;
+        if (takeSolver(*q, true, f))
+          f();
+      });
+  };
+
+  // cheap ones first: with few threads they give the others an incumbent
+  enqueue("greedy", false, [this](int i) { offer(i, greedyPacking(g)); end(i, true); });
+
+  enqueue("greedy-weight", false, [this](int i) {
+      vector<int> all(g->getN());
+      for (int v = 0; v < g->getN(); v++)
+        all[v] = v;
+      offer(i, repairPacking(g, all));
+      end(i, true);
+    });
+
+  enqueue("luby", false, [this](int i) { offer(i, lubyPacking(g, pool, 1)); end(i, true); });
+
+  enqueue("luby-weight", false, [this](int i) { offer(i, lubyPacking(g, pool, 1, true)); end(i, true); });
+
+  // only stops when cancelled, so it is left to workers until the deadline
+  if (g->getN() <= exactLimit)
+    enqueue("exact", true, [this](int i) { runExact(i); });
+
+  enqueue("local-search", false, [this](int i) { runLocalSearch(i, 1, false); });
+
+  enqueue("local-search-weight", false, [this](int i) { runLocalSearch(i, 2, true); });
+
+  // the caller works too, so a run() from inside a pool task can't
+  // wait for workers that are all busy (as in ThreadPool::parallelFor)
+  std::function<void()> solver;
+  while (takeSolver(*queue, false, solver))
+    solver();
+
+  std::unique_lock<std::mutex> guard(lock);
+  auto until = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(seconds));
+  if (!finished.wait_until(guard, until, [this]() { return running == 0; })) {
+    cancel = true;
+    for (auto s : searches)
+      s->stop();
+  }
+
+  // those still not started end at once
+  guard.unlock();
+  while (takeSolver(*queue, true, solver))
+    solver();
+  guard.lock();
+  finished.wait(guard, [this]() { return running == 0; });
+}
+
+void Portfolio::print(void) const
+{
+  for (auto &e : entries)
+    printf("%-20s value: %g, time: %.3fs%s\n", e.name.c_str(), e.value, e.time, e.finished ? "" : " (stopped)");
+  printf("winner: %s, value: %g, bound: %g%s\n", winner >= 0 ? entries[winner].name.c_str() : "none",
+         bestValue, bound.best(), optimal ? " (optimal)" : "");
+}
@@ -0,0 +1,147 @@
+/**
+   Copyright (C) 2016 Diego Rubert
+
+   This file is part of the O(k)-approximation algorithm implementation
+   for the DCJ distance on linear unichromosomal genomes in:
+
+   Diego P. Rubert, Pedro Feijão, Marília D. V. Braga, Jens Stoye and Fábio V. Martinez
+   A Linear Time Approximation Algorithm for the DCJ Distance for Genomes with Bounded Number of Duplicates
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+  Portfolio of packing heuristics raced on the same (read only)
+  conflict graph: greedy by degree and by weight, Luby (plain and
+  weighted), exact branch and bound when the graph is small and two
+  local searches, run concurrently on a thread pool with a shared
+  deadline. Every solver offers its solutions to a shared incumbent,
+  local searches restart from the incumbent when it is better than
+  their own best, and everything is cancelled as soon as the incumbent
+  meets the upper bound (PackingBound) or the exact search finishes.
+  The winner is the solver that first found the final incumbent.
+*/
+
+#ifndef _PORTFOLIO_HPP
+
+#define _PORTFOLIO_HPP 1
+
+#include <vector>
+#include <string>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+
+#include "graph.hpp"
+#include "conflict-graph.hpp"
+#include "bounds.hpp"
+#include "local-search.hpp"
+#include "thread-pool.hpp"
+
+
+
+/**************************
+ ** PORTFOLIOENTRY CLASS **
+ **************************/
+// Outcome of one solver of the portfolio
+struct PortfolioEntry {
+  std::string name;  // Solver
+  double value;      // Value of the best solution it found (-1 = none)
+  double time;       // Seconds until it found it
+  bool finished;     // Whether it ended by itself (not cancelled nor out of time)
+};
+
+
+/*********************
+ ** PORTFOLIO CLASS **
+ *********************/
+class Portfolio {
+private:
+  Graph *ag;                           // Adjacency graph (may be NULL, see DeltaScorer)
+  const ConflictGraph *g;              // Conflict graph
+  ThreadPool *pool;                    // Where solvers run
+  PackingBound bound;                  // Upper bounds on the optimum
+  int exactLimit;                      // Largest graph given to the exact solver
+
+  std::mutex lock;                     // Guards everything below
+  std::condition_variable finished;    // Signaled when a solver ends
+  std::vector<PortfolioEntry> entries; // One per solver
+  std::vector<int> best;               // Incumbent
+  double bestValue;                    // Its value
+  int winner;                          // Entry that found it (-1 = none)
+  bool optimal;                        // Whether it is proved optimal
+  int running;                         // Solvers not finished
+  std::vector<LocalSearch *> searches; // Local searches running (stopped on cancel)
+  std::atomic<bool> cancel;            // Set on deadline or optimality
+  std::chrono::steady_clock::time_point start; // When run() started
+  double deadline;                     // Seconds allowed
+
+  // Registers a solver, returns its entry
+  int add(const std::string &name);
+
+  // Offers a solution found by solver i (proved optimal or not), returns
+  // true if it became the incumbent. Cancels everything on optimality
+  bool offer(int i, const std::vector<int> &solution, bool proved = false);
+
+  // Marks solver i as ended (by itself or not)
+  void end(int i, bool byItself);
+
+  // Returns the incumbent and its value
+  std::vector<int> incumbent(double &value);
+
+  // Seconds since run() started
+  double elapsed(void) const;
+
+  // Whether solvers must stop
+  inline bool done(void) const { return cancel || elapsed() >= deadline; }
+
+  // The solvers
+  void runLocalSearch(int i, unsigned seed, bool weightFirst);
+  void runExact(int i);
+
+public:
+  // Receives the adjacency graph the CyclesGraph frozen in g was built
+  // from (or NULL), the pool to run on and the size up to which the
+  // exact solver is used
+  Portfolio(Graph *ag, const ConflictGraph *g, ThreadPool *pool, int exactLimit = 256);
+
+  // Races all solvers for at most seconds, returns when all ended. The
+  // calling thread runs solvers too, so it may be a task of the pool
+  void run(double seconds);
+
+  // Returns the best solution found
+  inline const std::vector<int> &getBest(void) const { return best; }
+
+  // Returns its value
+  inline double getBestValue(void) const { return bestValue; }
+
+  // Returns the name of the solver that found it ("" if none)
+  inline std::string getWinner(void) const { return winner >= 0 ? entries[winner].name : ""; }
+
+  // Returns true if it is known to be optimal
+  inline bool isOptimal(void) const { return optimal; }
+
+  // Returns the bounds
+  inline const PackingBound &getBound(void) const { return bound; }
+
+  // Returns the outcome of each solver
+  inline const std::vector<PortfolioEntry> &getEntries(void) const { return entries; }
+
+  // Prints the outcome of each solver and the winner
+  void print(void) const;
+};
+
+
+#endif /* portfolio.hpp  */
@@ -0,0 +1,295 @@
+/**
+   Copyright (C) 2016 Diego Rubert
+
+   This file is part of the O(k)-approximation algorithm implementation
+   for the DCJ distance on linear unichromosomal genomes in:
+
+   Diego P. Rubert, Pedro Feijão, Marília D. V. Braga, Jens Stoye and Fábio V. Martinez
+   A Linear Time Approximation Algorithm for the DCJ Distance for Genomes with Bounded Number of Duplicates
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdio>
+#include <cstddef>
+#include <cstring>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+
+#include "genome.hpp"
+#include "decomposition.hpp"
+#include "packing.hpp"
+#include "genome-cache.hpp"
+#include "result-cache.hpp"
+
+
+using std::vector;
+
+
+
+/*******************
+ ** AUX FUNCTIONS **
+ *******************/
+static const uint32_t MAGIC = 0x31524446; // "FDR1", changes with the layout
+static const uint32_t ORDER = 0x01020304;
+
+// Record of a cache file
+struct ResultRecord {
+  uint32_t magic;      // MAGIC
+  uint32_t order;      // ORDER, as written by the writer
+  uint64_t key[4];     // a, b, similarity, params
+  int32_t genes, cycles, oddPaths, evenPaths, distance;
+  int32_t maxLen, enumerated, packed, memoized, fallback;
+  double similarity;
+  double seconds;
+  uint64_t checksum;   // Hash of everything above
+};
+
+static_assert(sizeof(ResultRecord) == 104, "records are written as 104-byte blocks");
+
+// Returns the checksum of a record
+static inline uint64_t checksum(const ResultRecord &rec)
+{
+  return contentHash(&rec, offsetof(ResultRecord, checksum), MAGIC);
+}
+
+// Chains an int into h
+static inline uint64_t chain(uint64_t h, int64_t x)
+{
+  return contentHash(&x, sizeof(x), h);
+}
+
+
+
+/**************************
+ ** RESULT KEY FUNCTIONS **
+ **************************/
+uint64_t genomeHash(const Genome &g)
+{
+  uint64_t h = chain(0, g.getChromosomes());
+
+  for (int c = 0; c < g.getChromosomes(); c++) {
+    h = chain(h, g.chromosomeEnd(c) - g.chromosomeBegin(c));
+    h = chain(h, g.isCircular(c));
+    for (int i = g.chromosomeBegin(c); i < g.chromosomeEnd(c); i++) {
+      const char *name = g.getGeneName(i);
+      h = chain(h, g.getGene(i).reverse ? -g.getGene(i).family : g.getGene(i).family);
+      h = contentHash(name, strlen(name) + 1, h);
+    }
+  }
+
+  return h;
+}
+
+ResultKey resultKey(uint64_t a, uint64_t b, uint64_t similarity, const ResultParams &params)
+{
+  uint64_t h = chain(0, params.maxLen);
+
+  h = chain(h, params.copyThreshold);
+  h = chain(h, params.collapse);
+  h = chain(h, params.memo);
+  h = chain(h, params.solver);
+  h = chain(h, params.seed);
+
+  return ResultKey{a, b, similarity, h};
+}
+
+
+
+/***************************
+ ** CACHED RESULT METHODS **
+ ***************************/
+CachedResult CachedResult::summarize(const PackingEngine &engine, double seconds)
+{
+  CachedResult r = {engine.getScore(), engine.getMaxLen(), 0, 0, engine.getMemoized(),
+                    engine.getFallback().getPairs(), seconds};
+
+  for (int len = 2; len <= engine.getMaxLen(); len += 2) {
+    r.enumerated += engine.getEnumerated(len);
+    r.packed += engine.getPacked(len);
+  }
+
+  return r;
+}
+
+void CachedResult::print(void) const
+{
+  printf("max len: %d, enumerated: %d, packed: %d, memoized: %d, fallback pairs: %d, %.3fs\n",
+         maxLen, enumerated, packed, memoized, fallback, seconds);
+  score.print();
+}
+
+
+
+/*************************
+ ** RESULTCACHE METHODS **
+ *************************/
+ResultCache::ResultCache() :
+  fd(-1),
+  offset(0),
+  records(0),
+  skipped(0)
+{
+}
+
+ResultCache::~ResultCache()
+{
+  close();
+}
+
+bool ResultCache::readTail(void)
+{
+  struct stat st;
+
+  if (fstat(fd, &st) != 0)
+    return false;
+  if ((uint64_t) st.st_size <= offset)
+    return true;
+
+  vector<char> buf(st.st_size - offset);
+  size_t n = 0;
+  while (n < buf.size()) {
+    ssize_t got = pread(fd, buf.data() + n, buf.size() - n, offset + n);
+    if (got <= 0)
+      return false;
+    n += got;
+  }
+
+  size_t pos = 0;
+  while (pos + sizeof(ResultRecord) <= n) {
+    ResultRecord rec;
+    memcpy(&rec, buf.data() + pos, sizeof(rec));
+    if (rec.magic != MAGIC || rec.order != ORDER || rec.checksum != checksum(rec)) {
+      pos++; // torn or foreign record, resynchronize
+      skipped++;
+      continue;
+    }
+
+    DCJScore s = {rec.genes, rec.cycles, rec.oddPaths, rec.evenPaths, rec.distance, rec.similarity};
+    results[ResultKey{rec.key[0], rec.key[1], rec.key[2], rec.key[3]}] =
+      CachedResult{s, rec.maxLen, rec.enumerated, rec.packed, rec.memoized, rec.fallback, rec.seconds};
+    records++;
+    pos += sizeof(rec);
+  }
+  offset += pos; // an incomplete tail is read again next time
+
+  return true;
+}
+
+bool ResultCache::open(const char *path)
+{
+  close();
+
+  std::lock_guard<std::mutex> guard(lock);
+  fd = ::open(path, O_RDWR | O_APPEND | O_CREAT, 0644);
+  if (fd < 0)
+    return false;
+  this->path = path;
+
+  return readTail();
+}
+
+void ResultCache::close(void)
+{
+  std::lock_guard<std::mutex> guard(lock);
+
+  if (fd >= 0)
+    ::close(fd);
+  fd = -1;
+  offset = records = skipped = 0;
+  results.clear();
+  path.clear();
+}
+
+bool ResultCache::refresh(void)
+{
+  std::lock_guard<std::mutex> guard(lock);
+
+  return fd >= 0 && readTail();
+}
+
+bool ResultCache::find(const ResultKey &key, CachedResult &r) const
+{
+  std::lock_guard<std::mutex> guard(lock);
+  auto it = results.find(key);
+
+  if (it == results.end())
+    return false;
+  r = it->second;
+  return true;
+}
+
+bool ResultCache::store(const ResultKey &key, const CachedResult &r)
+{
+  ResultRecord rec;
+
+  memset(&rec, 0, sizeof(rec));
+  rec.magic = MAGIC;
+  rec.order = ORDER;
+  rec.key[0] = key.a;
+  rec.key[1] = key.b;
+  rec.key[2] = key.similarity;
+  rec.key[3] = key.params;
+  rec.genes = r.score.genes;
+  rec.cycles = r.score.cycles;
+  rec.oddPaths = r.score.oddPaths;
+  rec.evenPaths = r.score.evenPaths;
+  rec.distance = r.score.distance;
+  rec.maxLen = r.maxLen;
+  rec.enumerated = r.enumerated;
+  rec.packed = r.packed;
+  rec.memoized = r.memoized;
+  rec.fallback = r.fallback;
+  rec.similarity = r.score.similarity;
+  rec.seconds = r.seconds;
+  rec.checksum = checksum(rec);
+
+  std::lock_guard<std::mutex> guard(lock);
+  if (fd < 0 || flock(fd, LOCK_EX) != 0)
+    return false;
+  ssize_t n = write(fd, &rec, sizeof(rec)); // O_APPEND: one record lands whole at the end
+  flock(fd, LOCK_UN);
+  if (n != (ssize_t) sizeof(rec))
+    return false;
+
+  results[key] = r; // read again (harmlessly) by the next refresh
+  return true;
+}
+
+size_t ResultCache::size(void) const
+{
+  std::lock_guard<std::mutex> guard(lock);
+
+  return results.size();
+}
+
+size_t ResultCache::getSkipped(void) const
+{
+  std::lock_guard<std::mutex> guard(lock);
+
+  return skipped;
+}
+
+void ResultCache::print(void) const
+{
+  std::lock_guard<std::mutex> guard(lock);
+
+  printf("%s: %zu results (%zu records read), %zu damaged bytes skipped\n", path.c_str(), results.size(), records, skipped);
+}
@@ -0,0 +1,177 @@
+/**
+   Copyright (C) 2016 Diego Rubert
+
+   This file is part of the O(k)-approximation algorithm implementation
+   for the DCJ distance on linear unichromosomal genomes in:
+
+   Diego P. Rubert, Pedro Feijão, Marília D. V. Braga, Jens Stoye and Fábio V. Martinez
+   A Linear Time Approximation Algorithm for the DCJ Distance for Genomes with Bounded Number of Duplicates
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+  Persistent store of pair results, so reruns skip pairs whose inputs
+  haven't changed. A result is keyed by content hashes of both genomes
+  (families, strands, chromosomes and gene names), of the similarity
+  data (chosen by the caller, e.g. hashFile() of the hits, 0 for none)
+  and of the parameters of the run (including whether a memo solved
+  small pieces, as that changes the packing), and holds the DCJ scores
+  and a summary of the packing rounds; looking it up never builds a
+  Graph. The drivers here only cache PackingEngine runs (solver 0).
+
+  The file is a plain sequence of fixed-size records, each with a tag,
+  the full key, the result and a checksum. Writers only ever append,
+  a whole record per write() under an exclusive flock(), so any number
+  of processes on one machine may share a file; readers need no lock:
+  records failing their checksum (torn by a crash, or written with
+  another byte order) are skipped, resynchronizing byte by byte, and
+  an incomplete tail is left for the next refresh(). The latest record
+  of a key wins. The cache is safe to share between threads.
+*/
+
+#ifndef _RESULT_CACHE_HPP
+
+#define _RESULT_CACHE_HPP 1
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <mutex>
+
+#include "genome.hpp"
+#include "decomposition.hpp"
+#include "packing.hpp"
+
+
+
+/***********************
+ ** RESULT KEY STRUCT **
+ ***********************/
+// Parameters of a run that shape its result
+struct ResultParams {
+  int maxLen;        // Length of cycles in the last round (0 = 2k)
+  int copyThreshold; // High-copy fallback threshold (0 = none)
+  bool collapse;     // Whether synteny blocks were collapsed
+  bool memo;         // Whether small pieces were solved through a PackingMemo
+  int solver;        // Solver, as numbered by the caller (0 = packing)
+  unsigned seed;     // RNG seed of the solver (0 if unused)
+
+  // Returns the parameters of a PackingEngine run (solver 0, which
+  // is deterministic, so without a seed)
+  static inline ResultParams packing(int maxLen, int copyThreshold, bool collapse, bool memo) {
+    return ResultParams{maxLen, copyThreshold, collapse, memo, 0, 0};
+  }
+};
+
+// Key of a result
+struct ResultKey {
+  uint64_t a;          // Hash of genome A
+  uint64_t b;          // Hash of genome B
+  uint64_t similarity; // Hash of the similarity data
+  uint64_t params;     // Hash of the parameters
+
+  inline bool operator==(const ResultKey &k) const {
+    return a == k.a && b == k.b && similarity == k.similarity && params == k.params;
+  }
+};
+
+// Returns the content hash of a genome
+uint64_t genomeHash(const Genome &g);
+
+// Returns the key of comparing genomes with hashes a and b
+ResultKey resultKey(uint64_t a, uint64_t b, uint64_t similarity, const ResultParams &params);
+
+
+
+/**************************
+ ** CACHED RESULT STRUCT **
+ **************************/
+// Scores and packing summary of a pair
+struct CachedResult {
+  DCJScore score;  // Scores of the decomposition
+  int maxLen;      // Length of cycles in the last round
+  int enumerated;  // Cycles enumerated over all rounds
+  int packed;      // Cycles packed over all rounds
+  int memoized;    // Pieces solved through the memo
+  int fallback;    // Pairs chosen by the high-copy fallback
+  double seconds;  // Time taken by the run
+
+  // Summarizes a packing engine that has run
+  static CachedResult summarize(const PackingEngine &engine, double seconds);
+
+  // Prints the result
+  void print(void) const;
+};
+
+
+
+/***********************
+ ** RESULTCACHE CLASS **
+ ***********************/
+class ResultCache {
+private:
+  // Hashes a key for the table
+  struct KeyHash {
+    inline size_t operator()(const ResultKey &k) const { return (size_t) (k.a ^ k.b * 31 ^ k.similarity * 131 ^ k.params); }
+  };
+
+  std::string path;                                             // Cache file
+  int fd;                                                       // Open for appending (-1 = closed)
+  uint64_t offset;                                              // Bytes of the file read so far
+  std::unordered_map<ResultKey, CachedResult, KeyHash> results; // Latest result of each key
+  size_t records;                                               // Records read from the file
+  size_t skipped;                                               // Damaged bytes skipped
+  mutable std::mutex lock;                                      // Guards everything above
+
+  // Reads the records appended since the last read
+  bool readTail(void);
+
+public:
+  ResultCache();
+  ~ResultCache();
+
+  ResultCache(const ResultCache &) = delete;
+  ResultCache &operator=(const ResultCache &) = delete;
+
+  // Opens (creating it if needed) the cache file and reads it,
+  // returns false on error
+  bool open(const char *path);
+
+  // Closes the file (forgetting every result)
+  void close(void);
+
+  // Reads results appended by other writers since the last read,
+  // returns false on error
+  bool refresh(void);
+
+  // Looks up the result of key, returns false if there is none
+  bool find(const ResultKey &key, CachedResult &r) const;
+
+  // Appends the result of key, returns false on error
+  bool store(const ResultKey &key, const CachedResult &r);
+
+  // Returns the number of keys with results
+  size_t size(void) const;
+
+  // Returns the number of damaged bytes skipped
+  size_t getSkipped(void) const;
+
+  // Prints a summary
+  void print(void) const;
+};
+
+
+#endif /* result-cache.hpp  */
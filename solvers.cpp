@@ -0,0 +1,347 @@
+/**
+   Copyright (C) 2016 Diego Rubert
+
+   This file is part of the O(k)-approximation algorithm implementation
+   for the DCJ distance on linear unichromosomal genomes in:
+
+   Diego P. Rubert, Pedro Feijão, Marília D. V. Braga, Jens Stoye and Fábio V. Martinez
+   A Linear Time Approximation Algorithm for the DCJ Distance for Genomes with Bounded Number of Duplicates
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include <functional>
+
+#include "conflict-graph.hpp"
+#include "thread-pool.hpp"
+#include "solvers.hpp"
+
+
+using std::vector;
+
+
+
+/*******************
+ ** AUX FUNCTIONS **
+ *******************/
+// Mixes a vertex id with a seed (splitmix64 finalizer), used as priority
+static inline uint64_t mix(uint64_t x, uint64_t seed)
+{
+  x += seed * 0x9e3779b97f4a7c15ULL;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+// Runs body over [0, n) in chunks of grain (0 = as the pool does) on the
+// pool, or chunk after chunk on the calling thread if there is none
+static void forChunks(ThreadPool *pool, long n, const std::function<void(long, long, long)> &body, long grain = 0)
+{
+  if (pool)
+    pool->parallelFor(0, n, body, grain);
+  else if (grain <= 0)
+    body(0, n, 0);
+  else
+    for (long c = 0; c * grain < n; c++)
+      body(c * grain, std::min(n, (c + 1) * grain), c);
+}
+
+// Vertices in increasing order of degree, ties by decreasing weight
+static vector<int> greedyOrder(const ConflictGraph *g)
+{
+  vector<int> order(g->getN());
+
+  for (int v = 0; v < g->getN(); v++)
+    order[v] = v;
+  std::stable_sort(order.begin(), order.end(), [g](int a, int b) {
+      if (g->degree(a) != g->degree(b))
+        return g->degree(a) < g->degree(b);
+      return g->weight(a) > g->weight(b);
+    });
+
+  return order;
+}
+
+
+// Branch and bound state of exactPacking (vertices renumbered by
+// decreasing degree, so the lowest set bit is the branching vertex)
+struct ExactSearch {
+  int n, words;
+  std::vector<int> label;         // Original vertex of each position
+  std::vector<double> w;          // Weight of each position
+  std::vector<uint64_t> closed;   // Closed neighborhoods, words per position
+  std::vector<uint64_t> cand;     // Candidate sets, words per depth
+  std::vector<uint64_t> cover;    // Scratch for the bound
+  std::vector<int> current, best;
+  double bestValue;
+  const std::atomic<bool> *stop;
+  long nodes;
+  bool aborted;
+
+  // Weight of a greedy clique cover of P (upper bound on what P adds)
+  double bound(const uint64_t *P)
+  {
+    double total = 0;
+    uint64_t *Q = cover.data(), *C = Q + words;
+
+    std::copy(P, P + words, Q);
+    for (int i = 0; i < words; i++)
+      while (Q[i]) {
+        int v = 64 * i + __builtin_ctzll(Q[i]);
+        double heaviest = w[v];
+        for (int j = 0; j < words; j++) // C: candidates adjacent to the whole clique
+          C[j] = Q[j] & closed[(long) v * words + j];
+        C[i] &= ~(1ULL << (v & 63));
+        Q[i] &= ~(1ULL << (v & 63));
+        for (int j = i; j < words; j++)
+          while (C[j]) {
+            int u = 64 * j + __builtin_ctzll(C[j]);
+            heaviest = std::max(heaviest, w[u]);
+            Q[j] &= ~(1ULL << (u & 63));
+            for (int k = j; k < words; k++)
+              C[k] &= closed[(long) u * words + k];
+            C[j] &= ~(1ULL << (u & 63));
+          }
+        total += heaviest;
+      }
+
+    return total;
+  }
+
+  void search(int depth, double value)
+  {
+    uint64_t *P = cand.data() + (long) depth * words, *next = P + words;
+
+    for (;;) {
+      if (stop && (++nodes & 1023) == 0 && stop->load(std::memory_order_relaxed))
+        aborted = true;
+      if (aborted)
+        return;
+
+      int first = 0;
+      while (first < words && !P[first])
+        first++;
+      if (first == words) { // nothing else fits
+        if (value > bestValue + 1e-9) {
+          bestValue = value;
+          best = current;
+        }
+        return;
+      }
+      if (value + bound(P) <= bestValue + 1e-9)
+        return;
+
+      // with v, then without it
+      int v = 64 * first + __builtin_ctzll(P[first]);
+      for (int j = 0; j < words; j++)
+        next[j] = P[j] & ~closed[(long) v * words + j];
+      current.push_back(v);
+      search(depth + 1, value + w[v]);
+      current.pop_back();
+      P[first] &= ~(1ULL << (v & 63));
+    }
+  }
+};
+
+
+
+/**********************
+ ** SOLVER FUNCTIONS **
+ **********************/
+vector<int> greedyPacking(const ConflictGraph *g)
+{
+  vector<int> chosen;
+  vector<char> blocked(g->getN(), 0);
+
+  for (auto v : greedyOrder(g))
+    if (!blocked[v]) {
+      chosen.push_back(v);
+      for (const int *u = g->begin(v); u != g->end(v); u++)
+        blocked[*u] = 1;
+    }
+
+  return chosen;
+}
+
+void completePacking(const ConflictGraph *g, vector<int> &solution)
+{
+  vector<char> blocked(g->getN(), 0);
+
+  for (auto v : solution) {
+    blocked[v] = 1;
+    for (const int *u = g->begin(v); u != g->end(v); u++)
+      blocked[*u] = 1;
+  }
+
+  for (auto v : greedyOrder(g))
+    if (!blocked[v]) {
+      solution.push_back(v);
+      for (const int *u = g->begin(v); u != g->end(v); u++)
+        blocked[*u] = 1;
+    }
+}
+
+vector<int> repairPacking(const ConflictGraph *g, const vector<int> &set)
+{
+  vector<int> order(set), chosen;
+  vector<char> blocked(g->getN(), 0);
+
+  std::stable_sort(order.begin(), order.end(), [g](int a, int b) {
+      if (g->weight(a) != g->weight(b))
+        return g->weight(a) > g->weight(b);
+      return g->degree(a) < g->degree(b);
+    });
+
+  for (auto v : order)
+    if (!blocked[v]) {
+      chosen.push_back(v);
+      blocked[v] = 1; // duplicates
+      for (const int *u = g->begin(v); u != g->end(v); u++)
+        blocked[*u] = 1;
+    }
+
+  completePacking(g, chosen);
+  return chosen;
+}
+
+vector<int> lubyPacking(const ConflictGraph *g, ThreadPool *pool, unsigned seed, bool weighted)
+{
+  enum : char { UNDECIDED = 0, IN, OUT };
+  int n = g->getN();
+  std::unique_ptr<std::atomic<char>[]> status(new std::atomic<char>[n]);
+  vector<double> key(n, 0);    // primary priority (weighted only)
+  vector<uint64_t> rnd(n);     // random priority
+  vector<int> undecided(n), next(n), chosen;
+  vector<long> counts;         // per chunk, to compact undecided
+
+  forChunks(pool, n, [&](long from, long to, long) {
+      for (long v = from; v < to; v++) {
+        status[v].store(UNDECIDED, std::memory_order_relaxed);
+        rnd[v] = mix(v, seed);
+        if (weighted)
+          key[v] = g->weight(v) / (g->degree(v) + 1);
+        undecided[v] = v;
+      }
+    });
+
+  auto beats = [&](int u, int v) { // true if u has priority over v
+    if (key[u] != key[v])
+      return key[u] > key[v];
+    if (rnd[u] != rnd[v])
+      return rnd[u] > rnd[v];
+    return u > v;
+  };
+
+  long left = n;
+  while (left > 0) {
+    // 1. local maxima among undecided vertices join (two neighbors can't
+    // both be maxima, so a neighbor seen IN already had priority)
+    forChunks(pool, left, [&](long from, long to, long) {
+        for (long i = from; i < to; i++) {
+          int v = undecided[i];
+          bool max = true;
+          for (const int *u = g->begin(v); u != g->end(v) && max; u++)
+            if (status[*u].load(std::memory_order_relaxed) != OUT && beats(*u, v))
+              max = false;
+          if (max)
+            status[v].store(IN, std::memory_order_relaxed);
+        }
+      });
+
+    // 2. their neighbors leave
+    forChunks(pool, left, [&](long from, long to, long) {
+        for (long i = from; i < to; i++) {
+          int v = undecided[i];
+          if (status[v].load(std::memory_order_relaxed) == IN)
+            for (const int *u = g->begin(v); u != g->end(v); u++)
+              status[*u].store(OUT, std::memory_order_relaxed);
+        }
+      });
+
+    // 3. compact the undecided list (count per chunk, prefix sums, copy)
+    long grain = std::max(1024L, left / (4L * ((pool ? pool->size() : 0) + 1)));
+    long chunks = (left + grain - 1) / grain;
+    counts.assign(chunks + 1, 0);
+    forChunks(pool, left, [&](long from, long to, long c) {
+        for (long i = from; i < to; i++)
+          if (status[undecided[i]].load(std::memory_order_relaxed) == UNDECIDED)
+            counts[c + 1]++;
+      }, grain);
+    for (long c = 0; c < chunks; c++)
+      counts[c + 1] += counts[c];
+    forChunks(pool, left, [&](long from, long to, long c) {
+        long k = counts[c];
+        for (long i = from; i < to; i++)
+          if (status[undecided[i]].load(std::memory_order_relaxed) == UNDECIDED)
+            next[k++] = undecided[i];
+      }, grain);
+    left = counts[chunks];
+    undecided.swap(next);
+  }
+
+  for (int v = 0; v < n; v++)
+    if (status[v].load(std::memory_order_relaxed) == IN)
+      chosen.push_back(v);
+  return chosen;
+}
+
+bool exactPacking(const ConflictGraph *g, vector<int> &solution, const std::atomic<bool> *stop)
+{
+  ExactSearch s;
+  int n = g->getN();
+  vector<int> pos(n);
+
+  s.n = n;
+  s.words = (n + 63) / 64;
+  s.label.resize(n);
+  for (int v = 0; v < n; v++)
+    s.label[v] = v;
+  std::stable_sort(s.label.begin(), s.label.end(), [g](int a, int b) { return g->degree(a) > g->degree(b); });
+  for (int i = 0; i < n; i++)
+    pos[s.label[i]] = i;
+
+  s.w.resize(n);
+  s.closed.assign((long) n * s.words, 0);
+  for (int i = 0; i < n; i++) {
+    int v = s.label[i];
+    s.w[i] = g->weight(v);
+    s.closed[(long) i * s.words + i / 64] |= 1ULL << (i & 63);
+    for (const int *u = g->begin(v); u != g->end(v); u++)
+      s.closed[(long) i * s.words + pos[*u] / 64] |= 1ULL << (pos[*u] & 63);
+  }
+
+  s.cand.assign((long) (n + 1) * s.words, 0);
+  for (int i = 0; i < n; i++)
+    s.cand[i / 64] |= 1ULL << (i & 63);
+  s.cover.resize(2 * s.words);
+  s.bestValue = g->weight(solution);
+  s.stop = stop;
+  s.nodes = 0;
+  s.aborted = false;
+
+  s.search(0, 0);
+
+  if (!s.best.empty()) { // improved the incumbent
+    solution.clear();
+    for (auto i : s.best)
+      solution.push_back(s.label[i]);
+  }
+
+  return !s.aborted;
+}
@@ -0,0 +1,77 @@
+/**
+   Copyright (C) 2016 Diego Rubert
+
+   This file is part of the O(k)-approximation algorithm implementation
+   for the DCJ distance on linear unichromosomal genomes in:
+
+   Diego P. Rubert, Pedro Feijão, Marília D. V. Braga, Jens Stoye and Fábio V. Martinez
+   A Linear Time Approximation Algorithm for the DCJ Distance for Genomes with Bounded Number of Duplicates
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+  Solvers for the cycle packing problem, i.e. (weighted) independent
+  set on the conflict graph of a CyclesGraph. All of them work on the
+  frozen ConflictGraph and return the chosen vertices (frozen ids).
+*/
+
+#ifndef _SOLVERS_HPP
+
+#define _SOLVERS_HPP 1
+
+#include <vector>
+#include <atomic>
+
+#include "conflict-graph.hpp"
+#include "thread-pool.hpp"
+
+
+
+/**********************
+ ** SOLVER FUNCTIONS **
+ **********************/
+// Greedy maximal independent set: vertices in increasing order of
+// degree (ties by decreasing weight), each one taken if none of its
+// neighbors was taken before. O(n log n + m)
+std::vector<int> greedyPacking(const ConflictGraph *g);
+
+// Extends an independent set to a maximal one adding free vertices in
+// the greedyPacking order. O(n log n + m)
+void completePacking(const ConflictGraph *g, std::vector<int> &solution);
+
+// Makes an independent set of any vertex set: vertices in decreasing
+// order of weight (ties by increasing degree), each one kept if none of
+// its neighbors was kept before, then completed (completePacking)
+std::vector<int> repairPacking(const ConflictGraph *g, const std::vector<int> &set);
+
+// Parallel maximal independent set with deterministic random
+// priorities (Luby style): in each round every undecided vertex whose
+// priority beats all undecided neighbors joins the set and its
+// neighbors leave, O(log n) rounds w.h.p., O(n + m) work. Status is kept
+// in an atomic array, so the graph is only read. If weighted, the
+// priority is w/(deg+1) with random tie breaks. The result depends on
+// the seed but not on the number of threads (nor on having a pool:
+// without one it runs on the calling thread)
+std::vector<int> lubyPacking(const ConflictGraph *g, ThreadPool *pool, unsigned seed = 1, bool weighted = false);
+
+// Exact maximum weight independent set by branch and bound over bitset
+// adjacency (vertices by decreasing degree; bound: greedy clique cover
+// of the candidates), only for small graphs (a few hundred vertices).
+// On entry solution may hold a known independent set (incumbent). On
+// return it holds the best set found, which is optimal if true is
+// returned; false means stop was set before the search finished
+bool exactPacking(const ConflictGraph *g, std::vector<int> &solution, const std::atomic<bool> *stop = NULL);
+
+#endif /* solvers.hpp  */
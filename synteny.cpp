@@ -0,0 +1,166 @@
+/**
+   Copyright (C) 2016 Diego Rubert
+
+   This file is part of the O(k)-approximation algorithm implementation
+   for the DCJ distance on linear unichromosomal genomes in:
+
+   Diego P. Rubert, Pedro Feijão, Marília D. V. Braga, Jens Stoye and Fábio V. Martinez
+   A Linear Time Approximation Algorithm for the DCJ Distance for Genomes with Bounded Number of Duplicates
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdio>
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+#include "genome.hpp"
+#include "decomposition.hpp"
+#include "synteny.hpp"
+
+
+using std::vector;
+using std::pair;
+
+
+
+/***************************
+ ** SYNTENYBLOCKS METHODS **
+ ***************************/
+SyntenyBlocks::SyntenyBlocks(int minLength) :
+  minLength(minLength < 2 ? 2 : minLength),
+  hidden(0)
+{
+}
+
+int SyntenyBlocks::collapse(const Genome &a, const Genome &b, Genome &ca, Genome &cb)
+{
+  int families = std::max(a.getMaxFamily(), b.getMaxFamily()) + 1;
+  vector<int> countA(families, 0), countB(families, 0), posB(families, -1);
+  vector<int> blockOfA(a.getGenes(), -1), blockOfB(b.getGenes(), -1);
+
+  blocks.clear();
+  origA.clear();
+  origB.clear();
+  hidden = 0;
+
+  for (int i = 0; i < a.getGenes(); i++)
+    countA[a.getGene(i).family]++;
+  for (int j = 0; j < b.getGenes(); j++) {
+    countB[b.getGene(j).family]++;
+    posB[b.getGene(j).family] = j;
+  }
+
+  // partner in B of gene i of A, -1 unless both are single-copy
+  auto partner = [&](int i) {
+    int f = a.getGene(i).family;
+    return f > 0 && countA[f] == 1 && countB[f] == 1 ? posB[f] : -1;
+  };
+
+  for (int c = 0; c < a.getChromosomes(); c++) {
+    int end = a.chromosomeEnd(c);
+
+    for (int i = a.chromosomeBegin(c); i < end; ) {
+      int j = partner(i), k = i + 1;
+      if (j < 0) {
+        i++;
+        continue;
+      }
+
+      // extend while the next gene of A follows j in B (or precedes it, if reversed)
+      bool rev = a.getGene(i).reverse != b.getGene(j).reverse;
+      for (int last = j; k < end; k++) {
+        int next = partner(k);
+        if (next < 0 || next != last + (rev ? -1 : 1) || b.getGene(next).chromosome != b.getGene(last).chromosome ||
+            (a.getGene(k).reverse != b.getGene(next).reverse) != rev)
+          break;
+        last = next;
+      }
+
+      if (k - i >= minLength) {
+        SyntenyBlock block{families + (int) blocks.size(), rev, vector<int>(), vector<int>()};
+        for (int x = i; x < k; x++) {
+          block.a.push_back(x);
+          block.b.push_back(partner(x));
+          blockOfA[x] = blockOfB[partner(x)] = (int) blocks.size();
+        }
+        hidden += k - i - 1;
+        blocks.push_back(block);
+      }
+      i = k;
+    }
+  }
+
+  // copy genomes, each block becoming a super-gene where it starts
+  const Genome *in[2] = {&a, &b};
+  Genome *out[2] = {&ca, &cb};
+  vector<int> *blockOf[2] = {&blockOfA, &blockOfB};
+  vector<vector<int>> *orig[2] = {&origA, &origB};
+  char label[32];
+
+  for (int g = 0; g < 2; g++) {
+    out[g]->clear();
+    out[g]->setName(in[g]->getName());
+    for (int c = 0; c < in[g]->getChromosomes(); c++) {
+      out[g]->addChromosome(in[g]->isCircular(c));
+      for (int i = in[g]->chromosomeBegin(c); i < in[g]->chromosomeEnd(c); i++) {
+        int k = (*blockOf[g])[i];
+        if (k < 0) {
+          out[g]->addGene(in[g]->getGene(i).family, in[g]->getGene(i).reverse, in[g]->getGeneName(i));
+          orig[g]->push_back(vector<int>(1, i));
+          continue;
+        }
+
+        const vector<int> &genes = g == 0 ? blocks[k].a : blocks[k].b;
+        if (i != std::min(genes.front(), genes.back()))
+          continue;
+
+        snprintf(label, sizeof(label), "block%d", k + 1);
+        out[g]->addGene(blocks[k].family, g == 1 && blocks[k].reverse, label);
+        orig[g]->push_back(genes);
+      }
+    }
+  }
+
+  return (int) blocks.size();
+}
+
+vector<pair<int, int>> SyntenyBlocks::expand(const vector<pair<int, int>> &pairs) const
+{
+  vector<pair<int, int>> expanded;
+
+  for (auto &p : pairs) { // both sides of a pair hide the same number of genes
+    const vector<int> &x = origA[p.first], &y = origB[p.second];
+    for (size_t i = 0; i < x.size() && i < y.size(); i++)
+      expanded.push_back(std::make_pair(x[i], y[i]));
+  }
+
+  return expanded;
+}
+
+DCJScore SyntenyBlocks::expand(const DCJScore &s) const
+{
+  DCJScore r = s;
+
+  r.genes += hidden;
+  r.cycles += hidden;
+  r.similarity += hidden;
+  return r;
+}
+
+void SyntenyBlocks::print(void) const
+{
+  printf("%zu synteny blocks, %d genes hidden in each genome\n", blocks.size(), hidden);
+}
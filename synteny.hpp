@@ -0,0 +1,104 @@
+/**
+   Copyright (C) 2016 Diego Rubert
+
+   This file is part of the O(k)-approximation algorithm implementation
+   for the DCJ distance on linear unichromosomal genomes in:
+
+   Diego P. Rubert, Pedro Feijão, Marília D. V. Braga, Jens Stoye and Fábio V. Martinez
+   A Linear Time Approximation Algorithm for the DCJ Distance for Genomes with Bounded Number of Duplicates
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+  Synteny block collapsing. Runs of single-copy genes (one copy of the
+  family in each genome) conserved in the same order and orientation
+  in both genomes (or reversed as a whole in genome B) only contribute
+  trivial 2-cycles to any decomposition: such genes have a single
+  candidate each, so their matching is forced and every adjacency
+  inside the run is a cycle of length 2. Each maximal run (within a
+  chromosome, not across the ends of circular ones) is collapsed into
+  a single super-gene of a new family before the adjacency graph is
+  built, and results on the collapsed genomes are expanded back: a run
+  of k genes hides k - 1 genes and k - 1 cycles of unit weight, so the
+  distance is unchanged. O(n) over both genomes.
+*/
+
+#ifndef _SYNTENY_HPP
+
+#define _SYNTENY_HPP 1
+
+#include <vector>
+#include <utility>
+
+#include "genome.hpp"
+#include "decomposition.hpp"
+
+
+
+/************************
+ ** SYNTENYBLOCK CLASS **
+ ************************/
+// A maximal conserved run of single-copy genes
+struct SyntenyBlock {
+  int family;          // Family of the super-gene
+  bool reverse;        // Whether the run is reversed in genome B
+  std::vector<int> a;  // Genes of genome A, in order
+  std::vector<int> b;  // Genes of genome B matched to each gene of a
+};
+
+
+/*************************
+ ** SYNTENYBLOCKS CLASS **
+ *************************/
+class SyntenyBlocks {
+private:
+  int minLength;                        // Shortest run collapsed
+  std::vector<SyntenyBlock> blocks;     // Blocks found by the last collapse
+  std::vector<std::vector<int>> origA;  // Genes of A behind each gene of the collapsed A
+  std::vector<std::vector<int>> origB;  // Genes of B behind each gene of the collapsed B
+  int hidden;                           // Genes hidden in each genome (sum of run lengths - 1)
+
+public:
+  // Receives the length of the shortest run worth collapsing (>= 2)
+  SyntenyBlocks(int minLength = 2);
+
+  // Finds the maximal conserved runs of a and b and writes the
+  // collapsed genomes to ca and cb, returns the number of blocks
+  int collapse(const Genome &a, const Genome &b, Genome &ca, Genome &cb);
+
+  // Returns the blocks found
+  inline const std::vector<SyntenyBlock> &getBlocks(void) const { return blocks; }
+
+  // Returns the number of genes hidden in each genome
+  inline int getHidden(void) const { return hidden; }
+
+  // Returns the genes of A (B) behind gene i of the collapsed A (B)
+  inline const std::vector<int> &originalA(int i) const { return origA[i]; }
+  inline const std::vector<int> &originalB(int i) const { return origB[i]; }
+
+  // Maps pairs of matched genes (indices) of the collapsed genomes
+  // back to pairs of genes of the original genomes
+  std::vector<std::pair<int, int>> expand(const std::vector<std::pair<int, int>> &pairs) const;
+
+  // Maps the scores of a decomposition of the collapsed genomes back
+  // to the original genomes (adds the cycles inside blocks)
+  DCJScore expand(const DCJScore &s) const;
+
+  // Prints a summary
+  void print(void) const;
+};
+
+
+#endif /* synteny.hpp  */
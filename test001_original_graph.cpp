@@ -2,53 +2,52 @@
 #include <iostream>
 #include "graph.hpp"
 #include "paths-cycles.hpp"
+#include "genome.hpp"
+#include "adjacency-graph.hpp"
 
 using namespace std;
 
 int main ()
 
 {
-    char nome[10];
-    //Graph *graph = new Graph();
-    Graph *graph = new Graph("grafo de testes", 10000);
-    cout << "teste" << endl;
-
-    //alocar vrtices
-
-
-
-    //alocar extremidades
-
-
-
-    //associar extremidades aos vrtices
-
-
-
-    //alocar arestas
-
-
-    //associar arestas aos vrtices
-
-
-
-    //associar arestas s extremidades
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
+    Genome a("A"), b("B");
+    Graph *graph;
+    int sibling = 0;
+
+    // A: 1 -2 3 1 | (4 5)
+    a.addGene(1); a.addGene(2, true); a.addGene(3); a.addGene(1);
+    a.addChromosome(true);
+    a.addGene(4); a.addGene(5);
+
+    // B: 1 2 -3 | (5 4) 1 |
+    b.addGene(1); b.addGene(2); b.addGene(3, true);
+    b.addChromosome(true);
+    b.addGene(5); b.addGene(4);
+    b.addChromosome();
+    b.addGene(1);
+
+    graph = buildAdjacencyGraph(a, b);
+    a.print();
+    b.print();
+
+    // vertices: 5 + 2 adjacencies of A, 4 + 2 + 2 of B
+    // edges: 2 per candidate pair, family 1 has 2 x 2 copies
+    cout << "vertices: " << graph->getN() << ", edges: " << graph->getM() << endl;
+    if (graph->getN() != 15 || graph->getM() != 2 * (4 + 1 + 1 + 1 + 1))
+        return 1;
+
+    // every edge joins same-type extremities and has a sibling joining the other ones
+    for (auto it = graph->begin('A'); it != graph->end(); ++it)
+        for (auto e : **it) {
+            Extremity from = e->getExtremityFrom(), to = e->getExtremityTo();
+            Edge *s = e->getSibling();
+            if (from.getType() != to.getType() || s == NULL ||
+                s->getExtremityFrom() != !from || s->getExtremityTo() != !to)
+                return 1;
+            sibling++;
+        }
+    cout << "edges with siblings: " << sibling << endl;
+
+    delete graph;
     return 0;
 }
@@ -0,0 +1,75 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <iostream>
+#include "graph.hpp"
+#include "genome.hpp"
+#include "adjacency-graph.hpp"
+#include "packing-memo.hpp"
+#include "packing.hpp"
+
+using namespace std;
+
+// Random genome with some chromosomes over few families, so pieces
+// recur and earlier rounds remove vertices of genes left for the memo
+static Genome randomGenome(const char *name, int families)
+{
+    Genome g(name);
+    int chromosomes = 1 + rand() % 3;
+
+    for (int c = 0; c < chromosomes; c++) {
+        if (c > 0)
+            g.addChromosome(rand() % 2);
+        int n = 1 + rand() % 12;
+        for (int i = 0; i < n; i++)
+            g.addGene(1 + rand() % families, rand() % 2);
+    }
+    return g;
+}
+
+int main ()
+
+{
+    PackingMemo memo;
+    int hits = 0, worse = 0, differ = 0, bad = 0;
+
+    srand(1);
+    for (int t = 0; t < 500; t++) {
+        Genome a = randomGenome("A", 6), b = randomGenome("B", 6);
+
+        // several rounds (up to 8-cycles) with a shared memo (served by
+        // hits of earlier pairs), with a fresh memo and without memo
+        PackingMemo fresh;
+        Graph *g1 = buildAdjacencyGraph(a, b), *g2 = buildAdjacencyGraph(a, b), *g3 = buildAdjacencyGraph(a, b);
+        PackingEngine with(g1, 8, &memo), without(g2, 8), alone(g3, 8, &fresh);
+        long before = memo.getHits();
+        with.run();
+        without.run();
+        alone.run();
+        delete g1;
+        delete g2;
+        delete g3;
+        hits += memo.getHits() - before;
+
+        // solving pieces optimally never hurts, and hits are as good as solving again
+        if (with.getScore().distance > without.getScore().distance)
+            worse++;
+        if (with.getScore().distance != alone.getScore().distance)
+            differ++;
+
+        // every gene is matched at most once, and mates are mutual
+        for (int id = 1; id <= a.getGenes() + b.getGenes(); id++) {
+            int m = with.getMate(id);
+            if (m != 0 && with.getMate(m) != id)
+                bad++;
+        }
+        const DCJScore &s = with.getScore();
+        if (s.distance != s.genes - s.cycles - s.oddPaths / 2 || s.genes != without.getScore().genes)
+            bad++;
+    }
+
+    cout << "memo hits: " << hits << ", cached: " << memo.size() << ", worse than without memo: " << worse
+         << ", differing from a fresh memo: " << differ << endl;
+    if (bad > 0 || worse > 0 || differ > 0 || hits == 0 || memo.size() == 0)
+        return 1;
+    return 0;
+}
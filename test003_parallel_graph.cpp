@@ -0,0 +1,81 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "graph.hpp"
+#include "genome.hpp"
+#include "gene-matching.hpp"
+#include "adjacency-graph.hpp"
+#include "thread-pool.hpp"
+
+using namespace std;
+
+// Random genome with some (linear or circular) chromosomes
+static Genome randomGenome(const char *name, int families)
+{
+    Genome g(name);
+    int chromosomes = 1 + rand() % 4;
+
+    for (int c = 0; c < chromosomes; c++) {
+        if (c > 0)
+            g.addChromosome(rand() % 2);
+        int n = 1 + rand() % 30;
+        for (int i = 0; i < n; i++)
+            g.addGene(1 + rand() % families, rand() % 2);
+    }
+    return g;
+}
+
+// Everything about a graph, edges in list order, siblings by label
+static string dump(Graph *graph)
+{
+    ostringstream s;
+
+    s << graph->getN() << " " << graph->getM() << "\n";
+    for (auto v : *graph) {
+        Extremity l = v->getExtremityLeft(), r = v->getExtremityRight();
+        s << v->getId() << (char) v->getPart() << " " << l.index() << " " << r.index() << " " << v->getDegree() << ":";
+        for (auto e : *v) {
+            Edge *sibling = e->getSibling();
+            s << " " << e->getAdj()->getId() << "/" << e->getLabel() << "/" << e->getExtremityFrom().index()
+              << "/" << e->getExtremityTo().index() << "/" << e->getWeight() << "/" << (sibling ? sibling->getLabel() : "-");
+        }
+        s << "\n";
+    }
+    return s.str();
+}
+
+int main ()
+
+{
+    ThreadPool pool(4);
+    int bad = 0;
+
+    srand(1);
+    for (int t = 0; t < 300; t++) {
+        Genome a = randomGenome("A", 2 + rand() % 20), b = randomGenome("B", 2 + rand() % 20);
+
+        // joining families
+        Graph *seq = buildAdjacencyGraph(a, b), *par = buildAdjacencyGraph(a, b, &pool);
+        if (dump(seq) != dump(par))
+            bad++;
+        delete seq;
+        delete par;
+
+        // joining given pairs
+        vector<GenePair> pairs;
+        for (int k = rand() % (a.getGenes() * b.getGenes() / 4 + 1); k > 0; k--)
+            pairs.push_back(GenePair{rand() % a.getGenes(), rand() % b.getGenes(), (double) (1 + rand() % 100)});
+        seq = buildAdjacencyGraph(a, b, pairs);
+        par = buildAdjacencyGraph(a, b, pairs, &pool);
+        if (dump(seq) != dump(par))
+            bad++;
+        delete seq;
+        delete par;
+    }
+
+    cout << "graphs differing from the sequential build: " << bad << endl;
+    return bad > 0;
+}
@@ -0,0 +1,77 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <iostream>
+#include <vector>
+#include "genome.hpp"
+#include "synteny.hpp"
+
+using namespace std;
+
+// Random genome over few families, so some are single-copy and runs form
+static Genome randomGenome(const char *name, int families)
+{
+    Genome g(name);
+    int chromosomes = 1 + rand() % 3;
+
+    for (int c = 0; c < chromosomes; c++) {
+        if (c > 0)
+            g.addChromosome(rand() % 2);
+        int n = 1 + rand() % 12;
+        for (int i = 0; i < n; i++)
+            g.addGene(1 + rand() % families, rand() % 2);
+    }
+    return g;
+}
+
+// Checks the collapsed genomes against the blocks found, returns false if inconsistent
+static bool consistent(const Genome &a, const Genome &b, const SyntenyBlocks &blocks, const Genome &ca, const Genome &cb)
+{
+    size_t genes = 0;
+
+    if (ca.getGenes() != a.getGenes() - blocks.getHidden() || cb.getGenes() != b.getGenes() - blocks.getHidden())
+        return false;
+    for (int i = 0; i < ca.getGenes(); i++)
+        genes += blocks.originalA(i).size();
+    for (int j = 0; j < cb.getGenes(); j++)
+        genes += blocks.originalB(j).size();
+    if (genes != (size_t) (a.getGenes() + b.getGenes()))
+        return false;
+
+    // block genes are consecutive in A and B, with the same families
+    for (auto &k : blocks.getBlocks())
+        for (size_t x = 0; x < k.a.size(); x++) {
+            if (a.getGene(k.a[x]).family != b.getGene(k.b[x]).family || (x > 0 && k.a[x] != k.a[x-1] + 1))
+                return false;
+            if (x > 0 && k.b[x] != k.b[x-1] + (k.reverse ? -1 : 1))
+                return false;
+        }
+    return true;
+}
+
+int main ()
+
+{
+    SyntenyBlocks blocks;
+    Genome ca, cb;
+    int bad = 0;
+
+    // a reversed run reaching the start of B followed by a gene of A
+    // without single-copy partner: A = 1 2 5 5, B = -2 -1 5 5
+    Genome a("A"), b("B");
+    a.addGene(1); a.addGene(2); a.addGene(5); a.addGene(5);
+    b.addGene(2, true); b.addGene(1, true); b.addGene(5); b.addGene(5);
+    blocks.collapse(a, b, ca, cb);
+    cout << "blocks: " << blocks.getBlocks().size() << ", hidden: " << blocks.getHidden() << endl;
+    if (blocks.getBlocks().size() != 1 || !blocks.getBlocks()[0].reverse || !consistent(a, b, blocks, ca, cb))
+        return 1;
+
+    srand(1);
+    for (int t = 0; t < 1000; t++) {
+        Genome x = randomGenome("A", 3 + rand() % 20), y = randomGenome("B", 3 + rand() % 20);
+        blocks.collapse(x, y, ca, cb);
+        if (!consistent(x, y, blocks, ca, cb))
+            bad++;
+    }
+    cout << "inconsistent collapses: " << bad << endl;
+    return bad > 0;
+}
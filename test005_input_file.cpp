@@ -0,0 +1,123 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <zlib.h>
+#include "input-file.hpp"
+#include "thread-pool.hpp"
+
+using namespace std;
+
+// Appends n little endian bytes of x
+static void little(string &s, unsigned long x, int n)
+{
+    for (int i = 0; i < n; i++)
+        s += (char) ((x >> (8 * i)) & 0xff);
+}
+
+// One BGZF block holding data (at most 64 KB)
+static string bgzfBlock(const string &data)
+{
+    vector<unsigned char> out(compressBound(data.size()) + 64);
+    z_stream z = z_stream();
+    deflateInit2(&z, 6, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY);
+    z.next_in = (Bytef *) data.data();
+    z.avail_in = data.size();
+    z.next_out = out.data();
+    z.avail_out = out.size();
+    deflate(&z, Z_FINISH);
+    deflateEnd(&z);
+
+    string s = string("\x1f\x8b\x08\x04\0\0\0\0\0\xff\x06\0BC\x02\0", 16);
+    little(s, 12 + 6 + z.total_out + 8 - 1, 2);
+    s.append((const char *) out.data(), z.total_out);
+    little(s, crc32(0, (const Bytef *) data.data(), data.size()), 4);
+    little(s, data.size(), 4);
+    return s;
+}
+
+// A gzip member holding data
+static string gzipMember(const string &data)
+{
+    vector<unsigned char> out(compressBound(data.size()) + 64);
+    z_stream z = z_stream();
+    deflateInit2(&z, 6, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY);
+    z.next_in = (Bytef *) data.data();
+    z.avail_in = data.size();
+    z.next_out = out.data();
+    z.avail_out = out.size();
+    deflate(&z, Z_FINISH);
+    deflateEnd(&z);
+    return string((const char *) out.data(), z.total_out);
+}
+
+static void save(const string &path, const string &content)
+{
+    FILE *f = fopen(path.c_str(), "wb");
+    fwrite(content.data(), 1, content.size(), f);
+    fclose(f);
+}
+
+// Whether the file reads back as expected, whole and in pieces
+static bool check(const string &path, const string &expected, InputFile::Format format, ThreadPool *pool)
+{
+    InputFile in;
+    const char *begin, *end;
+    string pieces;
+
+    if (!in.open(path.c_str()) || in.getFormat() != format)
+        return false;
+    if (!in.read(begin, end, pool) || string(begin, end) != expected)
+        return false;
+    if (!in.read([&](const char *b, const char *e) { pieces.append(b, e); }, pool, 1000))
+        return false;
+    return pieces == expected;
+}
+
+int main ()
+
+{
+    ThreadPool pool(4);
+    string base = "/tmp/test005_" + to_string(getpid()), text, bgzf, gzip;
+    string eof = bgzfBlock("");
+    int bad = 0;
+
+    srand(1);
+    for (int i = 0; i < 20000; i++)
+        text += "gene" + to_string(rand() % 5000) + "\tgene" + to_string(rand() % 5000) + "\t" + to_string(rand() % 100) + "\n";
+
+    // BGZF blocks of random sizes, gzip members of 100 KB
+    for (size_t pos = 0; pos < text.size(); ) {
+        size_t n = min(text.size() - pos, (size_t) (1 + rand() % 65536));
+        bgzf += bgzfBlock(text.substr(pos, n));
+        pos += n;
+    }
+    for (size_t pos = 0; pos < text.size(); pos += 100000)
+        gzip += gzipMember(text.substr(pos, 100000));
+
+    save(base + ".tsv", text);
+    save(base + ".bgz", bgzf + eof);
+    save(base + ".gz", gzip);
+    save(base + ".empty.bgz", eof);
+    save(base + ".torn.bgz", bgzf.substr(0, bgzf.size() / 2));
+
+    for (ThreadPool *p : {(ThreadPool *) NULL, &pool}) {
+        bad += !check(base + ".tsv", text, InputFile::PLAIN, p);
+        bad += !check(base + ".bgz", text, InputFile::BGZF, p);
+        bad += !check(base + ".gz", text, InputFile::GZIP, p);
+        bad += !check(base + ".empty.bgz", "", InputFile::BGZF, p);
+
+        // a torn BGZF file is not BGZF, and is corrupt as gzip
+        InputFile in;
+        const char *begin, *end;
+        bad += !in.open((base + ".torn.bgz").c_str()) || in.getFormat() != InputFile::GZIP || in.read(begin, end, p);
+    }
+
+    for (const char *suffix : {".tsv", ".bgz", ".gz", ".empty.bgz", ".torn.bgz"})
+        remove((base + suffix).c_str());
+
+    cout << "files read differently from the plain one: " << bad << endl;
+    return bad > 0;
+}
@@ -0,0 +1,99 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "name-index.hpp"
+#include "blast.hpp"
+#include "thread-pool.hpp"
+
+using namespace std;
+
+// Random BLAST tabular hits, with comments, empty and malformed lines
+static string randomHits(int lines, int genes)
+{
+    ostringstream s;
+
+    for (int i = 0; i < lines; i++) {
+        int kind = rand() % 20;
+        if (kind == 0)
+            s << "# BLASTP 2.2.28+\n";
+        else if (kind == 1)
+            s << "\n";
+        else if (kind == 2)
+            s << "g" << rand() % genes << "\tg" << rand() % genes << "\tnot a number\n";
+        else {
+            int a = rand() % genes, b = kind == 3 ? a : rand() % genes;
+            s << "g" << a << "\tg" << b << "\t" << rand() % 10000 / 100.0 << "\t" << 50 + rand() % 300
+              << "\t3\t1\t1\t100\t1\t100\t" << (rand() % 100) << "e-" << rand() % 50 << "\t" << rand() % 5000 / 10.0 << "\n";
+        }
+    }
+    if (lines % 2)
+        s << "g0\tg1\t90\t100\t3\t1\t1\t100\t1\t100\t1e-10\t200"; // no last newline
+    return s.str();
+}
+
+// Names, edges and counters left by a parse
+static string dump(const NameIndex &names, const vector<SimilarityEdge> &edges, const BlastParser &parser)
+{
+    ostringstream s;
+
+    for (int i = 0; i < names.size(); i++)
+        s << names.name(i) << " ";
+    s << "\n";
+    for (auto &e : edges)
+        s << e.a << " " << e.b << " " << e.weight << "\n";
+    s << parser.getLines() << " " << parser.getKept() << " " << parser.getMalformed() << "\n";
+    return s.str();
+}
+
+// Parses text in pieces (twice, into the same index and edges) on pool
+static string parse(const string &text, const BlastOptions &options, ThreadPool *pool, size_t chunkSize)
+{
+    NameIndex names;
+    vector<SimilarityEdge> edges;
+    BlastParser parser(&names, options);
+    size_t half = text.find('\n', text.size() / 2);
+
+    names.insert("g7"); // ids already given
+    half = half == string::npos ? text.size() : half + 1;
+    if (pool) {
+        parser.parse(text.data(), text.data() + half, edges, pool, chunkSize);
+        parser.parse(text.data() + half, text.data() + text.size(), edges, pool, chunkSize);
+    }
+    else {
+        parser.parse(text.data(), text.data() + half, edges);
+        parser.parse(text.data() + half, text.data() + text.size(), edges);
+    }
+    return dump(names, edges, parser);
+}
+
+int main ()
+
+{
+    ThreadPool pool(4);
+    int bad = 0;
+
+    srand(1);
+    for (int t = 0; t < 100; t++) {
+        string text = randomHits(rand() % 400, 1 + rand() % 200);
+        BlastOptions options;
+
+        if (t % 2) {
+            options.minScore = rand() % 200;
+            options.maxEvalue = 1e-10;
+            options.minIdentity = rand() % 50;
+            options.identity = rand() % 2;
+            options.self = rand() % 2;
+        }
+
+        string sequential = parse(text, options, NULL, 0);
+        for (size_t chunkSize : {(size_t) 1, (size_t) 97, (size_t) 1000, (size_t) 0})
+            if (parse(text, options, &pool, chunkSize) != sequential)
+                bad++;
+    }
+
+    cout << "chunked parses differing from the sequential one: " << bad << endl;
+    return bad > 0;
+}
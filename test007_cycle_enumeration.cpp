@@ -0,0 +1,116 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <forward_list>
+#include <unordered_set>
+#include "graph.hpp"
+#include "genome.hpp"
+#include "adjacency-graph.hpp"
+#include "paths-cycles.hpp"
+
+using namespace std;
+
+// Random genome with some (linear or circular) chromosomes
+static Genome randomGenome(const char *name, int families)
+{
+    Genome g(name);
+    int chromosomes = 1 + rand() % 3;
+
+    for (int c = 0; c < chromosomes; c++) {
+        if (c > 0)
+            g.addChromosome(rand() % 2);
+        int n = 1 + rand() % 8;
+        for (int i = 0; i < n; i++)
+            g.addGene(1 + rand() % families, rand() % 2);
+    }
+    return g;
+}
+
+// The enumeration CycleEnumerator replaced: every path of length len
+// from every vertex of one part kept at once, cycles deduplicated by a
+// signature set of the whole graph
+static void referenceCycles(Graph *ag, int len, forward_list<Path *> *cycles)
+{
+    if (ag->getN() < 1 || len < 2)
+        return;
+
+    forward_list<Path *> *next, *list = new forward_list<Path *>;
+    unordered_set<string> signatures;
+    char part = ag->begin()->getPart();
+
+    for (auto it = ag->begin(part); it != ag->end(); ++it) {
+        list->push_front(new Path(*it));
+
+        for (int i = 0; i < len; i++) {
+            next = new forward_list<Path *>;
+            for (auto p : *list)
+                for (auto e : *p->last()) {
+                    if (!p->consistent(e))
+                        continue;
+                    bool cycle = p->isCycle(e);
+                    if (i < len - 1 && !cycle)
+                        next->push_front(new Path(*p + e->getAdj() + e));
+                    else if (i == len - 1 && cycle && *e > *p->firstE())
+                        next->push_front(new Path(*p + e));
+                }
+            for (auto p : *list)
+                delete p;
+            delete list;
+            list = next;
+        }
+
+        for (auto c : *list)
+            if (signatures.insert(c->signature()).second)
+                cycles->push_front(c);
+            else
+                delete c;
+        list->clear();
+    }
+
+    delete list;
+}
+
+// Signatures in list order, deleting the cycles
+static vector<string> signatures(forward_list<Path *> &cycles)
+{
+    vector<string> s;
+
+    for (auto c : cycles) {
+        s.push_back(c->signature());
+        delete c;
+    }
+    cycles.clear();
+    return s;
+}
+
+int main ()
+
+{
+    CycleEnumerator enumerator; // reused across graphs, as by PackingEngine
+    int bad = 0;
+
+    srand(9);
+    for (int t = 0; t < 400; t++) {
+        int families = 2 + rand() % 10;
+        Genome a = randomGenome("A", families), b = randomGenome("B", families);
+        Graph *ag = buildAdjacencyGraph(a, b);
+
+        for (int len = 2; len <= 6; len += 2) {
+            forward_list<Path *> reference, wrapped, reused;
+            referenceCycles(ag, len, &reference);
+            enumerateCycles(ag, len, &wrapped);
+            enumerator.enumerate(ag, len, &reused);
+
+            // same cycles in the same order, so packings don't change
+            vector<string> expected = signatures(reference);
+            if (signatures(wrapped) != expected || signatures(reused) != expected)
+                bad++;
+        }
+        delete ag;
+    }
+
+    cout << "enumerations differing from the reference: " << bad << endl;
+    return bad > 0;
+}
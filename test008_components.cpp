@@ -0,0 +1,97 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include "conflict-graph.hpp"
+#include "bounds.hpp"
+#include "solvers.hpp"
+#include "components.hpp"
+#include "thread-pool.hpp"
+
+using namespace std;
+
+// Random graph of some components of at most size vertices, numbered
+// in random order
+static ConflictGraph *randomGraph(int components, int size)
+{
+    vector<vector<int>> adj;
+    vector<int> order;
+    vector<double> w;
+
+    for (int c = 0; c < components; c++) {
+        int first = (int) adj.size(), n = 1 + rand() % size, p = 5 + rand() % 40;
+        adj.resize(first + n);
+        for (int i = first; i < first + n; i++) {
+            w.push_back(1 + rand() % 5);
+            for (int j = first; j < i; j++)
+                if (rand() % 100 < p) {
+                    adj[i].push_back(j);
+                    adj[j].push_back(i);
+                }
+        }
+    }
+    for (int v = 0; v < (int) adj.size(); v++)
+        order.push_back(v);
+    random_shuffle(order.begin(), order.end());
+
+    int n = (int) adj.size();
+    vector<int> off(1, 0), edges, at(n);
+    vector<double> weights(n);
+    for (int v = 0; v < n; v++)
+        at[order[v]] = v;
+    for (int v = 0; v < n; v++) {
+        for (int u : adj[order[v]])
+            edges.push_back(at[u]);
+        off.push_back((int) edges.size());
+        weights[v] = w[order[v]];
+    }
+    return new ConflictGraph(off, edges, weights);
+}
+
+// Optimum value, solving every component exactly on its own
+static double optimum(const ConflictGraph *g)
+{
+    vector<int> comp, local(g->getN());
+    int count = conflictComponents(g, comp);
+    vector<vector<int>> members(count);
+    double sum = 0;
+
+    for (int v = 0; v < g->getN(); v++) {
+        local[v] = (int) members[comp[v]].size();
+        members[comp[v]].push_back(v);
+    }
+    for (auto &vertices : members) {
+        ConflictGraph *sub = inducedGraph(g, vertices, local);
+        vector<int> s;
+        exactPacking(sub, s);
+        sum += sub->weight(s);
+        delete sub;
+    }
+    return sum;
+}
+
+int main ()
+
+{
+    ThreadPool pool(4);
+    int bad = 0;
+
+    srand(3);
+    for (int t = 0; t < 200; t++) {
+        // up to 30 vertices, all tiny with the largest limit
+        ConflictGraph *g = randomGraph(1 + rand() % 8, t % 4 ? 24 : 30);
+        double best = optimum(g), bound = PackingBound(g).best();
+
+        for (int tinyLimit : {0, 12, 30}) {
+            ComponentSolver solver(g, &pool, tinyLimit);
+            vector<int> s = solver.run(10);
+            if (!g->independent(s) || !solver.optimal() || g->weight(s) != best || g->weight(s) > bound + 1e-9)
+                bad++;
+        }
+        delete g;
+    }
+
+    cout << "component packings not optimal: " << bad << endl;
+    return bad > 0;
+}
@@ -0,0 +1,83 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <iostream>
+#include <vector>
+#include "graph.hpp"
+#include "genome.hpp"
+#include "adjacency-graph.hpp"
+#include "paths-cycles.hpp"
+#include "conflict-graph.hpp"
+#include "bounds.hpp"
+#include "solvers.hpp"
+#include "multilevel.hpp"
+
+using namespace std;
+
+// Random genome with some (linear or circular) chromosomes
+static Genome randomGenome(const char *name, int families, int genes)
+{
+    Genome g(name);
+    int chromosomes = 1 + rand() % 3;
+
+    for (int c = 0; c < chromosomes; c++) {
+        if (c > 0)
+            g.addChromosome(rand() % 2);
+        int n = 1 + rand() % genes;
+        for (int i = 0; i < n; i++)
+            g.addGene(1 + rand() % families, rand() % 2);
+    }
+    return g;
+}
+
+// Whether every coarse vertex of level l+1 is a clique of level l and
+// adjacent vertices of level l are in the same or adjacent coarse ones
+static bool sound(const MultilevelSolver &ml, int l)
+{
+    const ConflictGraph *fine = ml.getLevel(l), *coarse = ml.getLevel(l + 1);
+
+    for (int v = 0; v < fine->getN(); v++) {
+        int x = ml.coarseVertex(l, v);
+        if (x < 0 || x >= coarse->getN())
+            return false;
+        for (int u = 0; u < v; u++) {
+            int y = ml.coarseVertex(l, u);
+            if (x == y ? !fine->adjacent(u, v) : fine->adjacent(u, v) && !coarse->adjacent(x, y))
+                return false;
+        }
+    }
+    return true;
+}
+
+int main ()
+
+{
+    int bad = 0, deep = 0;
+
+    srand(5);
+    for (int t = 0; t < 40; t++) {
+        int families = 6 + rand() % 15;
+        Genome a = randomGenome("A", families, 35), b = randomGenome("B", families, 35);
+        Graph *ag = buildAdjacencyGraph(a, b);
+        CyclesGraph cg(ag, "cg", 4);
+        ConflictGraph g(&cg);
+
+        MultilevelSolver ml(ag, &g, t + 1, 10);
+        for (int l = 0; l + 1 < ml.getLevels(); l++)
+            if (!sound(ml, l))
+                bad++;
+        if (ml.getLevels() > 2)
+            deep++;
+
+        // starting from greedy never ends worse than it
+        vector<int> greedy = greedyPacking(&g), s = ml.run(0.05, 5, &greedy);
+        if (!g.independent(s) || g.weight(s) < g.weight(greedy) || g.weight(s) > PackingBound(&g).best() + 1e-9)
+            bad++;
+        s = ml.run(0.05, 5);
+        if (!g.independent(s) || g.weight(s) > PackingBound(&g).best() + 1e-9)
+            bad++;
+        delete ag;
+    }
+
+    cout << "unsound levels or packings: " << bad << ", graphs of more than 2 levels: " << deep << endl;
+    return bad > 0 || deep == 0;
+}
@@ -0,0 +1,109 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <iostream>
+#include <vector>
+#include "graph.hpp"
+#include "genome.hpp"
+#include "adjacency-graph.hpp"
+#include "paths-cycles.hpp"
+#include "conflict-graph.hpp"
+#include "bounds.hpp"
+#include "local-search.hpp"
+#include "warm-start.hpp"
+
+using namespace std;
+
+// Random genome with some (linear or circular) chromosomes
+static Genome randomGenome(const char *name, int families)
+{
+    Genome g(name);
+    int chromosomes = 1 + rand() % 3;
+
+    for (int c = 0; c < chromosomes; c++) {
+        if (c > 0)
+            g.addChromosome(rand() % 2);
+        int n = 1 + rand() % 30;
+        for (int i = 0; i < n; i++)
+            g.addGene(1 + rand() % families, rand() % 2);
+    }
+    return g;
+}
+
+// Same genome with some genes moved to other families
+static Genome mutate(const Genome &g, int families)
+{
+    Genome m(g.getName());
+
+    for (int c = 0; c < g.getChromosomes(); c++) {
+        if (c > 0)
+            m.addChromosome(g.isCircular(c));
+        for (int i = g.chromosomeBegin(c); i < g.chromosomeEnd(c); i++)
+            m.addGene(rand() % 10 ? g.getGene(i).family : 1 + rand() % families, g.getGene(i).reverse);
+    }
+    return m;
+}
+
+// Whether s is a maximal independent set of g
+static bool maximal(const ConflictGraph *g, const vector<int> &s)
+{
+    vector<bool> covered(g->getN(), false);
+
+    if (!g->independent(s))
+        return false;
+    for (int v : s) {
+        covered[v] = true;
+        for (const int *u = g->begin(v); u != g->end(v); u++)
+            covered[*u] = true;
+    }
+    for (int v = 0; v < g->getN(); v++)
+        if (!covered[v])
+            return false;
+    return true;
+}
+
+int main ()
+
+{
+    int bad = 0, dropped = 0;
+
+    srand(7);
+    for (int t = 0; t < 100; t++) {
+        int families = 10 + rand() % 20;
+        Genome a = randomGenome("A", families), b = randomGenome("B", families), c = mutate(b, families);
+        Graph *ag = buildAdjacencyGraph(a, b);
+        CyclesGraph cg(ag, "cg", 4);
+        ConflictGraph g(&cg);
+        LocalSearch search(ag, &g, t + 1);
+        search.run(1, 2L * g.getN());
+        EdgeSets sets = toEdgeSets(&g, search.getBest());
+
+        // the same genomes, rebuilt: every cycle is found again
+        Graph *same = buildAdjacencyGraph(a, b);
+        CyclesGraph cgSame(same, "cg", 4);
+        ConflictGraph gSame(&cgSame);
+        int unmapped = -1;
+        vector<int> s = warmStart(&gSame, sets, &unmapped);
+        if (unmapped != 0 || mapEdgeSets(&gSame, sets).size() != sets.size() || !maximal(&gSame, s) ||
+            gSame.weight(s) < g.weight(search.getBest()))
+            bad++;
+
+        // other genomes: cycles that are gone are dropped, the rest repaired
+        Graph *other = buildAdjacencyGraph(a, c);
+        CyclesGraph cgOther(other, "cg", 4);
+        ConflictGraph gOther(&cgOther);
+        s = warmStart(&gOther, sets, &unmapped);
+        if (!maximal(&gOther, s) || gOther.weight(s) > PackingBound(&gOther).best() + 1e-9)
+            bad++;
+        LocalSearch resumed(other, &gOther, t + 1);
+        if (resumed.init(sets) != unmapped)
+            bad++;
+        dropped += unmapped;
+
+        delete ag;
+        delete same;
+        delete other;
+    }
+
+    cout << "bad warm starts: " << bad << ", cycles dropped: " << dropped << endl;
+    return bad > 0 || dropped == 0;
+}
@@ -0,0 +1,86 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <iostream>
+#include <vector>
+#include "graph.hpp"
+#include "genome.hpp"
+#include "adjacency-graph.hpp"
+#include "paths-cycles.hpp"
+#include "conflict-graph.hpp"
+#include "bounds.hpp"
+#include "solvers.hpp"
+#include "portfolio.hpp"
+#include "thread-pool.hpp"
+
+using namespace std;
+
+// Random genome with some (linear or circular) chromosomes
+static Genome randomGenome(const char *name, int families)
+{
+    Genome g(name);
+    int chromosomes = 1 + rand() % 3;
+
+    for (int c = 0; c < chromosomes; c++) {
+        if (c > 0)
+            g.addChromosome(rand() % 2);
+        int n = 1 + rand() % 40;
+        for (int i = 0; i < n; i++)
+            g.addGene(1 + rand() % families, rand() % 2);
+    }
+    return g;
+}
+
+// Whether a portfolio result is a packing no better than possible and
+// no worse than greedy, and optimal if it says so
+static bool sound(Portfolio &p, const ConflictGraph *g)
+{
+    vector<int> exact;
+    double value = p.getBestValue();
+
+    if (!g->independent(p.getBest()) || g->weight(p.getBest()) != value || p.getWinner() == "")
+        return false;
+    if (value < g->weight(greedyPacking(g)) || value > PackingBound(g).best() + 1e-9)
+        return false;
+    if (p.isOptimal() && g->getN() <= 256 && exactPacking(g, exact) && g->weight(exact) != value)
+        return false;
+    return true;
+}
+
+int main ()
+
+{
+    ThreadPool pool(3);
+    int bad = 0, optimal = 0;
+
+    srand(11);
+    for (int t = 0; t < 30; t++) {
+        int families = 6 + rand() % 10;
+        Genome a = randomGenome("A", families), b = randomGenome("B", families);
+        Graph *ag = buildAdjacencyGraph(a, b);
+        CyclesGraph cg(ag, "cg", 4);
+        ConflictGraph g(&cg);
+
+        Portfolio p(ag, &g, &pool);
+        p.run(0.2);
+        if (!sound(p, &g))
+            bad++;
+        optimal += p.isOptimal();
+
+        // from tasks of the same pool, keeping every worker busy
+        vector<Portfolio *> nested;
+        for (int k = 0; k < pool.size(); k++)
+            nested.push_back(new Portfolio(ag, &g, &pool));
+        for (auto q : nested)
+            pool.submit([q]() { q->run(0.1); });
+        pool.wait();
+        for (auto q : nested) {
+            if (!sound(*q, &g))
+                bad++;
+            delete q;
+        }
+        delete ag;
+    }
+
+    cout << "bad portfolio runs: " << bad << ", proved optimal: " << optimal << endl;
+    return bad > 0 || optimal == 0;
+}
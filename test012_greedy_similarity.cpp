@@ -0,0 +1,85 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include "graph.hpp"
+#include "genome.hpp"
+#include "adjacency-graph.hpp"
+#include "decomposition.hpp"
+#include "greedy-similarity.hpp"
+
+using namespace std;
+
+// Random genome with some (linear or circular) chromosomes of the given
+// families, in random order and orientation
+static Genome randomGenome(const char *name, vector<int> families)
+{
+    Genome g(name);
+    size_t next = 0;
+
+    random_shuffle(families.begin(), families.end());
+    for (int c = 0; next < families.size(); c++) {
+        if (c > 0)
+            g.addChromosome(rand() % 2);
+        for (int n = 1 + rand() % 4; n > 0 && next < families.size(); n--)
+            g.addGene(families[next++], rand() % 2);
+    }
+    return g;
+}
+
+// Smallest distance over every matching of genes of A (from i on) to
+// free genes of B of the same family
+static int bestDistance(Decomposition &d, const Genome &a, const Genome &b, int i)
+{
+    if (i == a.getGenes())
+        return d.score().distance;
+
+    int best = a.getGenes();
+    for (int j = 0; j < b.getGenes(); j++)
+        if (b.getGene(j).family == a.getGene(i).family && d.getMate(a.getGenes() + j + 1) == 0) {
+            d.match(i + 1, a.getGenes() + j + 1);
+            best = min(best, bestDistance(d, a, b, i + 1));
+            d.unmatch(i + 1);
+        }
+    return best;
+}
+
+int main ()
+
+{
+    int bad = 0, worse = 0;
+
+    srand(13);
+    for (int t = 0; t < 300; t++) {
+        vector<int> families;
+        for (int n = 1 + rand() % 8, k = 2 + rand() % 4; n > 0; n--)
+            families.push_back(1 + rand() % k);
+        Genome a = randomGenome("A", families), b = randomGenome("B", families);
+        Graph *ag = buildAdjacencyGraph(a, b);
+        Decomposition d(ag);
+        int optimum = bestDistance(d, a, b, 0);
+
+        GreedySimilarity greedy(ag);
+        greedy.run();
+        const DCJScore &s = greedy.getScore();
+
+        // a complete matching of same family genes, scored consistently
+        for (int id = 1; id <= a.getGenes() + b.getGenes(); id++) {
+            int m = greedy.getMate(id);
+            if (m == 0 || greedy.getMate(m) != id || (id <= a.getGenes()) == (m <= a.getGenes()))
+                bad++;
+            else if (id <= a.getGenes() && a.getGene(id - 1).family != b.getGene(m - a.getGenes() - 1).family)
+                bad++;
+        }
+        if (s.genes != a.getGenes() || s.distance != s.genes - s.cycles - s.oddPaths / 2 ||
+            s.similarity != s.cycles + s.oddPaths / 2.0 || s.cycles < greedy.getTaken() || s.distance < optimum)
+            bad++;
+        if (s.distance > optimum)
+            worse++;
+        delete ag;
+    }
+
+    cout << "bad greedy decompositions: " << bad << ", worse than optimal: " << worse << endl;
+    return bad > 0;
+}
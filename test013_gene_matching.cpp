@@ -0,0 +1,87 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include "graph.hpp"
+#include "gene-matching.hpp"
+#include "thread-pool.hpp"
+
+using namespace std;
+
+// Whether pairs is a matching of edges of w (by vertex ids) of the given weight
+static bool valid(const vector<GenePair> &pairs, double weight, const vector<vector<double>> &w, int nA)
+{
+    vector<bool> used(nA + w[0].size(), false);
+    double sum = 0;
+
+    for (auto &p : pairs) {
+        int i = p.a, j = p.b - nA;
+        if (i < 0 || i >= nA || j < 0 || j >= (int) w[0].size() || used[p.a] || used[p.b] || w[i][j] != p.weight)
+            return false;
+        used[p.a] = used[p.b] = true;
+        sum += p.weight;
+    }
+    return sum - weight < 1e-9 && weight - sum < 1e-9;
+}
+
+int main ()
+
+{
+    ThreadPool pool(3);
+    int bad = 0, better = 0;
+
+    srand(7);
+    for (int t = 0; t < 400; t++) {
+        int nA = 1 + rand() % 7, nB = 1 + rand() % 7;
+        Graph sim("sim", 16);
+        vector<Vertex *> va, vb;
+        vector<vector<double>> w(nA, vector<double>(nB, 0));
+
+        // genes of A are vertices 0..nA-1, those of B follow
+        for (int i = 0; i < nA; i++)
+            va.push_back(sim.addVertex((const char *) 0, 'A'));
+        for (int j = 0; j < nB; j++)
+            vb.push_back(sim.addVertex((const char *) 0, 'B'));
+        for (int i = 0; i < nA; i++)
+            for (int j = 0; j < nB; j++)
+                if (rand() % 3 == 0) {
+                    w[i][j] = (rand() % 1000) / 10.0 + 0.1;
+                    Edge *e = sim.addEdge(va[i], vb[j]);
+                    e->setWeight(w[i][j]);
+                    e->getAdjRef()->setWeight(w[i][j]);
+                }
+
+        // optimum by dynamic programming over the genes of B taken
+        vector<double> best(1 << nB, -1);
+        best[0] = 0;
+        for (int i = 0; i < nA; i++) {
+            vector<double> next(best);
+            for (int s = 0; s < (1 << nB); s++)
+                for (int j = 0; j < nB; j++)
+                    if (best[s] >= 0 && w[i][j] > 0 && !(s >> j & 1))
+                        next[s | 1 << j] = max(next[s | 1 << j], best[s] + w[i][j]);
+            best = next;
+        }
+        double optimum = *max_element(best.begin(), best.end());
+
+        GeneMatching m(&sim);
+        m.greedy();
+        double greedy = m.getWeight();
+        if (!valid(m.getMatching(), greedy, w, nA) || greedy < optimum / 2 - 1e-9)
+            bad++;
+
+        // sequential and parallel auctions, within tolerance * (heaviest edge) of the optimum
+        for (ThreadPool *p : {(ThreadPool *) NULL, &pool}) {
+            m.auction(1e-6, p);
+            if (!valid(m.getMatching(), m.getWeight(), w, nA) || m.getWeight() > optimum + 1e-9 ||
+                m.getWeight() < optimum - 1e-6 * 100.1 || m.getWeight() < greedy - 1e-6 * 100.1)
+                bad++;
+            if (m.getWeight() > greedy + 1e-9)
+                better++;
+        }
+    }
+
+    cout << "bad matchings: " << bad << ", auctions heavier than greedy: " << better << endl;
+    return bad > 0 || better == 0;
+}
@@ -0,0 +1,119 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include "graph.hpp"
+#include "genome.hpp"
+#include "adjacency-graph.hpp"
+#include "decomposition.hpp"
+#include "high-copy.hpp"
+#include "packing.hpp"
+
+using namespace std;
+
+// Genome with the given families in order, split in a few chromosomes,
+// genes in random orientation
+static Genome makeGenome(const char *name, const vector<int> &families)
+{
+    Genome g(name);
+
+    for (size_t i = 0; i < families.size(); i++) {
+        if (i > 0 && rand() % 8 == 0)
+            g.addChromosome(rand() % 2);
+        g.addGene(families[i], rand() % 2);
+    }
+    return g;
+}
+
+// Smallest distance over every matching of genes of A (from i on) to
+// free genes of B of the same family
+static int bestDistance(Decomposition &d, const Genome &a, const Genome &b, int i)
+{
+    if (i == a.getGenes())
+        return d.score().distance;
+
+    int best = a.getGenes();
+    for (int j = 0; j < b.getGenes(); j++)
+        if (b.getGene(j).family == a.getGene(i).family && d.getMate(a.getGenes() + j + 1) == 0) {
+            d.match(i + 1, a.getGenes() + j + 1);
+            best = min(best, bestDistance(d, a, b, i + 1));
+            d.unmatch(i + 1);
+        }
+    return best;
+}
+
+int main ()
+
+{
+    int bad = 0, resolved = 0;
+
+    srand(5);
+    for (int t = 0; t < 200; t++) {
+        // families 1 and 2 have many copies, the rest one
+        int n = 6 + rand() % 4, copies[3] = {0, 0, 0};
+        vector<int> families;
+        for (int i = 0; i < n; i++) {
+            int f = rand() % 3 == 0 ? 1 + rand() % 2 : 3 + i;
+            families.push_back(f);
+            copies[min(f, 3) - 1]++;
+        }
+        Genome a = makeGenome("A", families);
+        random_shuffle(families.begin(), families.end());
+        Genome b = makeGenome("B", families);
+
+        Graph *original = buildAdjacencyGraph(a, b), *ag = buildAdjacencyGraph(a, b);
+        HighCopyFallback fallback(ag, 1);
+        Decomposition before(original), after(ag);
+        vector<bool> affected(a.getGenes() + b.getGenes() + 1, false);
+        for (int id : fallback.getAffected())
+            affected[id] = true;
+
+        // genes of resolved families (all paired, genomes are balanced)
+        // keep one partner, the others all of theirs
+        if (fallback.getLargest() != max(1, max(copies[0], copies[1])) || 2 * fallback.getPairs() != fallback.getGenes())
+            bad++;
+        for (int id = 1; id <= a.getGenes() + b.getGenes(); id++) {
+            int family = id <= a.getGenes() ? a.getGene(id - 1).family : b.getGene(id - a.getGenes() - 1).family;
+            if (affected[id] != (family <= 2 && copies[family - 1] > 1))
+                bad++;
+            else if (id <= a.getGenes() && (affected[id] ? after.candidates(id) != 1 : after.candidates(id) != before.candidates(id)))
+                bad++;
+        }
+        resolved += fallback.getFamilies();
+
+        // every edge left still has its sibling
+        for (auto it = ag->begin(ag->begin()->getPart()); it != ag->end(); ++it)
+            for (auto e : **it)
+                if (e->getSibling() == NULL || e->getSibling()->getSibling() != e)
+                    bad++;
+
+        // an engine run after the fallback never beats the optimum
+        PackingEngine engine(original, 0, NULL, 1);
+        engine.run();
+        if (engine.distance() < bestDistance(before, a, b, 0))
+            bad++;
+        delete original;
+        delete ag;
+    }
+
+    // identical genomes: context alone finds the pairs
+    vector<int> families;
+    for (int i = 0; i < 400; i++)
+        families.push_back(i % 10 == 0 ? 1 : 2 + i);
+    Genome a = makeGenome("A", families), b("B");
+    for (int c = 0; c < a.getChromosomes(); c++) {
+        if (c > 0)
+            b.addChromosome(a.isCircular(c));
+        for (int i = a.chromosomeBegin(c); i < a.chromosomeEnd(c); i++)
+            b.addGene(a.getGene(i).family, a.getGene(i).reverse);
+    }
+    Graph *ag = buildAdjacencyGraph(a, b);
+    PackingEngine engine(ag, 0, NULL, 8);
+    engine.run();
+    delete ag;
+
+    cout << "bad resolutions: " << bad << ", families resolved: " << resolved
+         << ", distance of identical genomes: " << engine.distance() << endl;
+    return bad > 0 || resolved == 0 || engine.distance() != 0;
+}
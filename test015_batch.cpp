@@ -0,0 +1,89 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include "graph.hpp"
+#include "genome.hpp"
+#include "synteny.hpp"
+#include "adjacency-graph.hpp"
+#include "decomposition.hpp"
+#include "packing.hpp"
+#include "thread-pool.hpp"
+#include "batch.hpp"
+
+using namespace std;
+
+// Genome of the ancestor's families after a few reversals and family
+// changes, so pairs share conserved runs, in a few chromosomes
+static Genome descendant(const char *name, vector<int> families)
+{
+    Genome g(name);
+    vector<bool> reverse(families.size(), false);
+
+    for (int k = rand() % 4; k > 0; k--) {
+        int i = rand() % families.size(), j = rand() % families.size();
+        if (i > j)
+            swap(i, j);
+        reverse_copy(families.begin() + i, families.begin() + j + 1, families.begin() + i);
+        reverse_copy(reverse.begin() + i, reverse.begin() + j + 1, reverse.begin() + i);
+        for (int x = i; x <= j; x++)
+            reverse[x] = !reverse[x];
+    }
+    for (size_t i = 0; i < families.size(); i++) {
+        if (i > 0 && rand() % 15 == 0)
+            g.addChromosome(rand() % 2);
+        g.addGene(rand() % 10 ? families[i] : 1 + rand() % 4, reverse[i]);
+    }
+    return g;
+}
+
+// Whether two scores are the same
+static bool same(const DCJScore &x, const DCJScore &y)
+{
+    return x.genes == y.genes && x.cycles == y.cycles && x.oddPaths == y.oddPaths && x.evenPaths == y.evenPaths &&
+           x.distance == y.distance && x.similarity == y.similarity;
+}
+
+int main ()
+
+{
+    ThreadPool pool(4);
+    vector<Genome> genomes;
+    vector<int> ancestor;
+    int bad = 0, collapsed = 0;
+
+    srand(7);
+    for (int i = 0; i < 40; i++)
+        ancestor.push_back(i % 4 == 0 ? 1 + rand() % 4 : 5 + i); // mostly single-copy
+    for (int k = 0; k < 6; k++)
+        genomes.push_back(descendant("G", ancestor));
+
+    for (bool collapse : {false, true})
+        for (ThreadPool *p : {(ThreadPool *) NULL, &pool}) {
+            BatchEngine batch(genomes, p, 0, 0, collapse);
+            batch.run();
+
+            // every pair as a single engine run, seen from both sides
+            for (int i = 0; i < batch.getN(); i++)
+                for (int j = i + 1; j < batch.getN(); j++) {
+                    SyntenyBlocks blocks;
+                    Genome a, b;
+                    if (collapse)
+                        collapsed += blocks.collapse(genomes[i], genomes[j], a, b) > 0;
+                    Graph *ag = collapse ? buildAdjacencyGraph(a, b) : buildAdjacencyGraph(genomes[i], genomes[j]);
+                    PackingEngine engine(ag);
+                    engine.run();
+                    delete ag;
+
+                    DCJScore s = collapse ? blocks.expand(engine.getScore()) : engine.getScore(), r = s;
+                    r.genes = genomes[j].getGenes();
+                    r.distance = r.genes - r.cycles - r.oddPaths / 2;
+                    if (!same(batch.getScore(i, j), s) || !same(batch.getScore(j, i), r))
+                        bad++;
+                }
+        }
+
+    cout << "pairs differing from single engine runs: " << bad << ", pairs with blocks collapsed: " << collapsed << endl;
+    return bad > 0 || collapsed == 0;
+}
@@ -0,0 +1,137 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "genome.hpp"
+#include "decomposition.hpp"
+#include "result-cache.hpp"
+#include "batch.hpp"
+
+using namespace std;
+
+// A result with every field set from k
+static CachedResult makeResult(int k)
+{
+    CachedResult r;
+
+    r.score = DCJScore{100 + k, k % 50, k % 7, k % 5, 100 + k - k % 50 - k % 7 / 2, k / 3.0};
+    r.maxLen = 2 * (k % 4);
+    r.enumerated = 10 * k;
+    r.packed = k;
+    r.memoized = k % 3;
+    r.fallback = k % 2;
+    r.seconds = k / 8.0;
+    return r;
+}
+
+// Whether the cache holds result k under key k
+static bool holds(const ResultCache &cache, int k, int version = 0)
+{
+    CachedResult r, e = makeResult(k + version);
+
+    if (!cache.find(ResultKey{(uint64_t) k, 1, 2, 3}, r))
+        return false;
+    return r.score.genes == e.score.genes && r.score.cycles == e.score.cycles && r.score.oddPaths == e.score.oddPaths &&
+           r.score.evenPaths == e.score.evenPaths && r.score.distance == e.score.distance &&
+           r.score.similarity == e.score.similarity && r.maxLen == e.maxLen && r.enumerated == e.enumerated &&
+           r.packed == e.packed && r.memoized == e.memoized && r.fallback == e.fallback && r.seconds == e.seconds;
+}
+
+static long fileSize(const string &path)
+{
+    struct stat s;
+    return stat(path.c_str(), &s) == 0 ? (long) s.st_size : -1;
+}
+
+static void append(const string &path, const string &bytes)
+{
+    FILE *f = fopen(path.c_str(), "ab");
+    fwrite(bytes.data(), 1, bytes.size(), f);
+    fclose(f);
+}
+
+int main ()
+
+{
+    string path = "/tmp/test016_" + to_string(getpid()) + ".cache";
+    int bad = 0;
+
+    // store, reopen and find, the latest record of a key winning
+    {
+        ResultCache cache;
+        if (!cache.open(path.c_str()))
+            return 1;
+        for (int k = 0; k < 100; k++)
+            bad += !cache.store(ResultKey{(uint64_t) k, 1, 2, 3}, makeResult(k));
+        bad += !cache.store(ResultKey{7, 1, 2, 3}, makeResult(8));
+        bad += !holds(cache, 7, 1) || cache.size() != 100;
+    }
+    long record = fileSize(path) / 101;
+    {
+        ResultCache cache;
+        bad += !cache.open(path.c_str()) || cache.size() != 100 || cache.getSkipped() != 0 || !holds(cache, 7, 1);
+        for (int k = 0; k < 100; k++)
+            bad += k != 7 && !holds(cache, k);
+        CachedResult r;
+        bad += cache.find(ResultKey{7, 1, 2, 4}, r); // other parameters
+    }
+
+    // a torn record (a writer crashed) at the end is left for later,
+    // garbage is skipped, records after both are still found
+    {
+        ResultCache writer;
+        writer.open(path.c_str());
+        writer.store(ResultKey{100, 1, 2, 3}, makeResult(100));
+    }
+    truncate(path.c_str(), fileSize(path) - record / 2);
+    {
+        ResultCache cache;
+        bad += !cache.open(path.c_str()) || cache.size() != 100 || holds(cache, 100) || !holds(cache, 99);
+    }
+    append(path, "garbage");
+    {
+        ResultCache writer, reader;
+        reader.open(path.c_str());
+        writer.open(path.c_str());
+        writer.store(ResultKey{101, 1, 2, 3}, makeResult(101));
+        bad += !reader.refresh() || !holds(reader, 101) || holds(reader, 100) || reader.size() != 101;
+    }
+    {
+        ResultCache cache;
+        bad += !cache.open(path.c_str()) || !holds(cache, 101) || !holds(cache, 0) || cache.size() != 101 ||
+               cache.getSkipped() != (size_t) (record - record / 2 + 7);
+    }
+    remove(path.c_str());
+
+    // a batch rerun finds every pair, with the same scores
+    vector<Genome> genomes;
+    srand(5);
+    for (int k = 0; k < 5; k++) {
+        Genome g("G");
+        for (int n = 10 + rand() % 30; n > 0; n--)
+            g.addGene(1 + rand() % 15, rand() % 2);
+        genomes.push_back(g);
+    }
+    {
+        ResultCache first, second;
+        first.open(path.c_str());
+        BatchEngine run(genomes, NULL, 0, 0, true, NULL, &first);
+        run.run();
+        second.open(path.c_str());
+        BatchEngine rerun(genomes, NULL, 0, 0, true, NULL, &second), other(genomes, NULL, 4, 0, true, NULL, &second);
+        rerun.run();
+        other.run();
+        bad += rerun.getHits() != 10 || other.getHits() != 0;
+        for (int i = 0; i < 5; i++)
+            for (int j = 0; j < 5; j++)
+                bad += i != j && (rerun.getScore(i, j).distance != run.getScore(i, j).distance ||
+                                  rerun.getScore(i, j).similarity != run.getScore(i, j).similarity);
+    }
+    remove(path.c_str());
+
+    cout << "bad cache lookups: " << bad << endl;
+    return bad > 0;
+}
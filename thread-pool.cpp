@@ -0,0 +1,143 @@
+/**
+   Copyright (C) 2016 Diego Rubert
+
+   This file is part of the O(k)-approximation algorithm implementation
+   for the DCJ distance on linear unichromosomal genomes in:
+
+   Diego P. Rubert, Pedro Feijão, Marília D. V. Braga, Jens Stoye and Fábio V. Martinez
+   A Linear Time Approximation Algorithm for the DCJ Distance for Genomes with Bounded Number of Duplicates
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <atomic>
+#include <algorithm>
+
+#include "thread-pool.hpp"
+
+
+
+/************************
+ ** THREADPOOL METHODS **
+ ************************/
+ThreadPool::ThreadPool(int threads) :
+  pending(0),
+  quit(false)
+{
+  if (threads <= 0)
+    threads = std::max(1u, std::thread::hardware_concurrency());
+
+  for (int i = 0; i < threads; i++)
+    workers.push_back(std::thread(&ThreadPool::work, this));
+}
+
+ThreadPool::~ThreadPool()
+{
+  wait();
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    quit = true;
+  }
+  ready.notify_all();
+  for (auto &t : workers)
+    t.join();
+}
+
+void ThreadPool::work(void)
+{
+  while (true) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> guard(lock);
+      ready.wait(guard, [this] { return quit || !tasks.empty(); });
+      if (tasks.empty()) // quit
+        return;
+      task = std::move(tasks.front());
+      tasks.pop_front();
+    }
+
+    task();
+
+    std::lock_guard<std::mutex> guard(lock);
+    if (--pending == 0)
+      idle.notify_all();
+  }
+}
+
+void ThreadPool::submit(std::function<void()> task)
+{
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    tasks.push_back(std::move(task));
+    pending++;
+  }
+  ready.notify_one();
+}
+
+void ThreadPool::wait(void)
+{
+  std::unique_lock<std::mutex> guard(lock);
+  idle.wait(guard, [this] { return pending == 0; });
+}
+
+void ThreadPool::parallelFor(long begin, long end, const std::function<void(long, long, long)> &body, long grain)
+{
+  if (end <= begin)
+    return;
+  if (grain <= 0)
+    grain = std::max(1L, (end - begin) / (4L * (size() + 1)));
+
+  long chunks = (end - begin + grain - 1) / grain;
+  if (chunks == 1) {
+    body(begin, end, 0);
+    return;
+  }
+
+  // shared with helpers, which may start after we returned (and find nothing to do)
+  struct State {
+    std::atomic<long> next;  // next chunk to take
+    std::atomic<long> done;  // chunks finished
+    std::mutex lock;
+    std::condition_variable finished;
+  };
+  std::shared_ptr<State> state = std::make_shared<State>();
+  state->next = 0;
+  state->done = 0;
+
+  const std::function<void(long, long, long)> *f = &body; // valid until all chunks are done
+  auto run = [state, f, begin, end, grain, chunks]() {
+    long c;
+    while ((c = state->next++) < chunks) {
+      (*f)(begin + c * grain, std::min(end, begin + (c + 1) * grain), c);
+      if (++state->done == chunks) {
+        std::lock_guard<std::mutex> guard(state->lock);
+        state->finished.notify_all();
+      }
+    }
+  };
+
+  int helpers = std::min((long) size(), chunks - 1);
+  for (int i = 0; i < helpers; i++)
+    submit(run);
+  run(); // the caller works too
+
+  std::unique_lock<std::mutex> guard(state->lock);
+  state->finished.wait(guard, [&state, chunks] { return state->done == chunks; });
+}
@@ -0,0 +1,87 @@
+/**
+   Copyright (C) 2016 Diego Rubert
+
+   This file is part of the O(k)-approximation algorithm implementation
+   for the DCJ distance on linear unichromosomal genomes in:
+
+   Diego P. Rubert, Pedro Feijão, Marília D. V. Braga, Jens Stoye and Fábio V. Martinez
+   A Linear Time Approximation Algorithm for the DCJ Distance for Genomes with Bounded Number of Duplicates
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+  Fixed size pool of worker threads. Tasks are run in submission order
+  by the first free worker. parallelFor() splits a range in chunks that
+  are taken by workers and by the calling thread itself, and waits only
+  for its own chunks, so it may be called from inside a task (nested)
+  without deadlocking even when every worker is busy.
+*/
+
+#ifndef _THREAD_POOL_HPP
+
+#define _THREAD_POOL_HPP 1
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+
+
+/**********************
+ ** THREADPOOL CLASS **
+ **********************/
+class ThreadPool {
+private:
+  std::vector<std::thread> workers;         // Worker threads
+  std::deque<std::function<void()>> tasks;  // Tasks not started yet
+  std::mutex lock;                          // Guards tasks, pending and quit
+  std::condition_variable ready;            // Signaled when a task is submitted (or quit)
+  std::condition_variable idle;             // Signaled when pending drops to zero
+  int pending;                              // Tasks submitted and not finished
+  bool quit;                                // Set on destruction
+
+  // Worker loop
+  void work(void);
+
+public:
+  // Creates a pool with some threads (0 = one per hardware thread)
+  ThreadPool(int threads = 0);
+
+  // Waits for every task submitted and joins the workers
+  ~ThreadPool();
+
+  // Not copyable
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  // Returns the number of worker threads
+  inline int size(void) const { return (int) workers.size(); }
+
+  // Submits a task
+  void submit(std::function<void()> task);
+
+  // Waits until every submitted task is finished (don't call from a task)
+  void wait(void);
+
+  // Runs body(from, to, chunk) over [begin, end) in chunks of grain
+  // indices (0 = about 4 chunks per thread), returns when all are done
+  void parallelFor(long begin, long end, const std::function<void(long, long, long)> &body, long grain = 0);
+};
+
+
+#endif /* thread-pool.hpp  */
@@ -0,0 +1,121 @@
+/**
+   Copyright (C) 2016 Diego Rubert
+
+   This file is part of the O(k)-approximation algorithm implementation
+   for the DCJ distance on linear unichromosomal genomes in:
+
+   Diego P. Rubert, Pedro Feijão, Marília D. V. Braga, Jens Stoye and Fábio V. Martinez
+   A Linear Time Approximation Algorithm for the DCJ Distance for Genomes with Bounded Number of Duplicates
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+#include <cstdint>
+
+#include "graph.hpp"
+#include "paths-cycles.hpp"
+#include "conflict-graph.hpp"
+#include "solvers.hpp"
+#include "warm-start.hpp"
+
+
+using std::vector;
+
+
+
+/*******************
+ ** AUX FUNCTIONS **
+ *******************/
+// Hashes a sorted edge set (FNV-1a over the extremity indices)
+static uint64_t hashSet(const vector<EdgeKey> &set)
+{
+  uint64_t h = 0xcbf29ce484222325ULL;
+
+  for (auto &k : set) {
+    h = (h ^ (uint64_t) k.first) * 0x100000001b3ULL;
+    h = (h ^ (uint64_t) k.second) * 0x100000001b3ULL;
+  }
+
+  return h;
+}
+
+
+
+/**************************
+ ** WARM START FUNCTIONS **
+ **************************/
+EdgeKey edgeKey(Edge *e)
+{
+  int a = e->getExtremityFrom().index(), b = e->getExtremityTo().index();
+  return a < b ? EdgeKey(a, b) : EdgeKey(b, a);
+}
+
+vector<EdgeKey> edgeSet(Path *p)
+{
+  vector<EdgeKey> set;
+
+  for (auto e : p->getEdges())
+    set.push_back(edgeKey(e));
+  std::sort(set.begin(), set.end());
+
+  return set;
+}
+
+EdgeSets toEdgeSets(const ConflictGraph *g, const vector<int> &solution)
+{
+  EdgeSets sets;
+
+  for (auto v : solution)
+    sets.push_back(edgeSet(g->cycle(v)));
+
+  return sets;
+}
+
+vector<int> mapEdgeSets(const ConflictGraph *g, const EdgeSets &sets, int *unmapped)
+{
+  std::unordered_multimap<uint64_t, int> index(g->getN());
+  vector<int> found;
+  int missing = 0;
+
+  for (int v = 0; v < g->getN(); v++)
+    index.insert(std::make_pair(hashSet(edgeSet(g->cycle(v))), v));
+
+  for (auto &s : sets) {
+    vector<EdgeKey> set(s);
+    std::sort(set.begin(), set.end());
+
+    int match = -1;
+    auto range = index.equal_range(hashSet(set));
+    for (auto it = range.first; it != range.second && match < 0; ++it)
+      if (edgeSet(g->cycle(it->second)) == set)
+        match = it->second;
+
+    if (match >= 0)
+      found.push_back(match);
+    else
+      missing++;
+  }
+
+  if (unmapped)
+    *unmapped = missing;
+  return found;
+}
+
+vector<int> warmStart(const ConflictGraph *g, const EdgeSets &sets, int *unmapped)
+{
+  return repairPacking(g, mapEdgeSets(g, sets, unmapped));
+}
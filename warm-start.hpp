@@ -0,0 +1,78 @@
+/**
+   Copyright (C) 2016 Diego Rubert
+
+   This file is part of the O(k)-approximation algorithm implementation
+   for the DCJ distance on linear unichromosomal genomes in:
+
+   Diego P. Rubert, Pedro Feijão, Marília D. V. Braga, Jens Stoye and Fábio V. Martinez
+   A Linear Time Approximation Algorithm for the DCJ Distance for Genomes with Bounded Number of Duplicates
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+  Warm starts: a packing (set of cycles) is carried from one conflict
+  graph to another as the edge sets of its cycles, each edge given by
+  its two gene extremities, which don't depend on the Graph objects
+  (the adjacency graph may be rebuilt, filtered or extended between
+  runs). Mapping finds the cycle with the same edge set in the new
+  graph, cycles that no longer exist are dropped and conflicts among
+  the rest are repaired heaviest first (repairPacking).
+*/
+
+#ifndef _WARM_START_HPP
+
+#define _WARM_START_HPP 1
+
+#include <vector>
+#include <utility>
+
+#include "graph.hpp"
+#include "paths-cycles.hpp"
+#include "conflict-graph.hpp"
+
+
+
+/***********
+ ** TYPES **
+ ***********/
+// An adjacency graph edge: indices (Extremity::index()) of its gene extremities, smaller first
+typedef std::pair<int, int> EdgeKey;
+
+// A packing: the sorted edge set of each cycle
+typedef std::vector<std::vector<EdgeKey>> EdgeSets;
+
+
+
+/**************************
+ ** WARM START FUNCTIONS **
+ **************************/
+// Returns the key of edge e
+EdgeKey edgeKey(Edge *e);
+
+// Returns the sorted edge set of path p
+std::vector<EdgeKey> edgeSet(Path *p);
+
+// Returns the edge sets of the cycles in solution (vertices of g)
+EdgeSets toEdgeSets(const ConflictGraph *g, const std::vector<int> &solution);
+
+// Returns the vertices of g whose cycles have the given edge sets (in
+// any order), sets without such a cycle are counted in unmapped
+std::vector<int> mapEdgeSets(const ConflictGraph *g, const EdgeSets &sets, int *unmapped = NULL);
+
+// Maps the edge sets onto g and repairs them into a maximal independent set
+std::vector<int> warmStart(const ConflictGraph *g, const EdgeSets &sets, int *unmapped = NULL);
+
+
+#endif /* warm-start.hpp  */